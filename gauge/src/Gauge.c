@@ -144,7 +144,7 @@ MENU_DESC diskMenuDesc[] =
 	{	NULL,					harddiskCallback,		NULL,			0x1007, NULL,	0,	1	},	/* 4:07 */
 	{	NULL,					harddiskCallback,		NULL,			0x1008, NULL,	0,	1	},	/* 4:08 */
 	{	NULL,					harddiskCallback,		NULL,			0x1009, NULL,	0,	1	},	/* 4:09 */
-	{	NULL,					harddiskCallback,		NULL,			0x1010, NULL,	0,	1	},	/* 4:10 */
+	{	NULL,					harddiskCallback,		NULL,			0x100A, NULL,	0,	1	},	/* 4:10 */
 	{	NULL,					NULL,					NULL,			0	}
 };
 
@@ -152,10 +152,13 @@ MENU_DESC harddiskMenuDesc[] =
 {
 	{	__("Partition Space"),	NULL,					spaceMenuDesc,		0		},	/* 5:00 */
 	{	"-",					NULL,					NULL,				0		},	/* 5:01 */
-	{	__("Sector Reads"),		harddiskCallback,		NULL,				0x100	},	/* 5:02 */
-	{	__("Sector Writes"),	harddiskCallback,		NULL,				0x200	},	/* 5:03 */
-	{	"-",					NULL,					NULL,				0		},	/* 5:04 */
-	{	__("Which Disk"),		NULL,					diskMenuDesc,		0		},	/* 5:05 */
+	{	__("Disk Reads"),		harddiskCallback,		NULL,				0x100	},	/* 5:02 */
+	{	__("Disk Writes"),		harddiskCallback,		NULL,				0x200	},	/* 5:03 */
+	{	__("Disk IOPS"),		harddiskCallback,		NULL,				0x300	},	/* 5:04 */
+	{	__("Queue Depth"),		harddiskCallback,		NULL,				0x400	},	/* 5:05 */
+	{	__("Await Time"),		harddiskCallback,		NULL,				0x500	},	/* 5:06 */
+	{	"-",					NULL,					NULL,				0		},	/* 5:07 */
+	{	__("Which Disk"),		NULL,					diskMenuDesc,		0		},	/* 5:08 */
 	{	NULL,					NULL,					NULL,				0		}
 };
 
@@ -349,6 +352,23 @@ MENU_DESC cpuMenuDesc[] =
 	{	NULL,					NULL,					NULL,				0		}
 };
 
+MENU_DESC wifiDevDesc[] =
+{
+	{	NULL,					wifiCallback,			NULL,				0,	NULL,	0,	1	},	/* M:00 */
+	{	NULL,					wifiCallback,			NULL,				1,	NULL,	0,	1	},	/* M:01 */
+	{	NULL,					wifiCallback,			NULL,				2,	NULL,	0,	1	},	/* M:02 */
+	{	NULL,					wifiCallback,			NULL,				3,	NULL,	0,	1	},	/* M:03 */
+	{	NULL,					NULL,					NULL,				0	}
+};
+
+MENU_DESC pressureMenuDesc[] =
+{
+	{	__("CPU"),				pressureCallback,		NULL,				0,	NULL,	0,	1	},	/* N:00 */
+	{	__("Memory"),			pressureCallback,		NULL,				1,	NULL,	0,	1	},	/* N:01 */
+	{	__("I/O"),				pressureCallback,		NULL,				2,	NULL,	0,	1	},	/* N:02 */
+	{	NULL,					NULL,					NULL,				0	}
+};
+
 MENU_DESC gaugeMenuDesc[] =
 {
 	{	__("Battery"),			batteryCallback,		NULL,				0,	NULL,	0,	1	},	/* J:00 */
@@ -359,11 +379,12 @@ MENU_DESC gaugeMenuDesc[] =
 	{	__("Moon Phase"),		moonPhaseCallback,		NULL,				0,	NULL,	0,	1	},	/* J:05 */
 	{	__("Network"),			NULL,					networkMenuDesc,	0,	NULL,	0,	1	},	/* J:06 */
 	{	__("Power"),			NULL,					powerMenuDesc,		1,	NULL,	0,	1	},	/* J:07 */
-	{	__("Sensor"),			NULL,					sensorMenuDesc,		0,	NULL,	0,	1	},	/* J:08 */
-	{	__("Thermometer"),		NULL,					thermoMenuDesc,		1,	NULL,	0,	1	},	/* J:09 */
-	{	__("Tide"),				NULL,					tideMenuDesc,		0,	NULL,	0,	1	},	/* J:10 */
-	{	__("Weather"),			NULL,					weatherMenuDesc,	0,	NULL,	0,	1	},	/* J:11 */
-	{	__("Wifi Quality"),		wifiCallback,			NULL,				0,	NULL,	0,	1	},	/* J:12 */
+	{	__("Pressure Stall"),	NULL,					pressureMenuDesc,	0,	NULL,	0,	1	},	/* J:08 */
+	{	__("Sensor"),			NULL,					sensorMenuDesc,		0,	NULL,	0,	1	},	/* J:09 */
+	{	__("Thermometer"),		NULL,					thermoMenuDesc,		1,	NULL,	0,	1	},	/* J:10 */
+	{	__("Tide"),				NULL,					tideMenuDesc,		0,	NULL,	0,	1	},	/* J:11 */
+	{	__("Weather"),			NULL,					weatherMenuDesc,	0,	NULL,	0,	1	},	/* J:12 */
+	{	__("Wifi Quality"),		NULL,					wifiDevDesc,		0,	NULL,	0,	1	},	/* J:13 */
 	{	NULL,					NULL,					NULL,				0	}
 };
 
@@ -407,6 +428,8 @@ static bool removeTaskbar		=  0;			/* Saved in the config file */
 static int lastKeyPressTime		=  0;
 static int keyPressFaceNum		= -1;
 static time_t lastTime			= -1;
+static guint tickSource			=  0;
+static int inTick				=  0;
 void updateGauge (void);
 
 /******************************************************************************************************
@@ -451,12 +474,13 @@ DIAL_CONFIG dialConfig =
 
 GAUGE_ENABLED gaugeEnabled[FACE_TYPE_MAX + 1] =
 {
-	{	"cpu_load",		1	},	{	"sensor_temp",	1	},	{	"sensor_fan",	1	},
-	{	"weather",		1	},	{	"memory",		1	},	{	"battery",		1	},
-	{	"network",		1	},	{	"entropy",		0	},	{	"tide",			1	},
-	{	"harddisk",		1	},	{	"thermo",		0	},	{	"power",		0	},
-	{	"moonphase",	1	},	{	"wifi",			1,	},	{	"sensor_input", 1	},
-	{	NULL,			0	}
+	{	"cpu_load",		1,	400		},	{	"sensor_temp",	1,	2000	},	{	"sensor_fan",	1,	2000	},
+	{	"weather",		1,	1000	},	{	"memory",		1,	3000	},	{	"battery",		1,	5000	},
+	{	"network",		1,	2000	},	{	"entropy",		0,	1000	},	{	"tide",			1,	2000	},
+	{	"harddisk",		1,	2000	},	{	"thermo",		0,	1000	},	{	"power",		0,	1000	},
+	{	"moonphase",	1,	5000	},	{	"wifi",			1,	2000	},	{	"sensor_input", 1,	2000	},
+	{	"pressure",		1,	2000	},
+	{	NULL,			0,	0		}
 };
 
 /******************************************************************************************************
@@ -774,6 +798,7 @@ windowClickCallback (GtkWidget * widget, GdkEventButton * event)
 	{
 		currentFace = ((int)event -> x / dialConfig.dialSize) + (((int)event -> y / dialConfig.dialSize) * dialConfig.dialWidth);
 		lastTime = -1;
+		tickWakeUp ();
 
 		switch (event->button)
 		{
@@ -891,6 +916,7 @@ windowKeyCallback (GtkWidget * widget, GdkEventKey * event)
 			{
 				currentFace = keyPressFaceNum;
 				lastTime = -1;
+				tickWakeUp ();
 			}
 		}
 	}
@@ -976,6 +1002,72 @@ int calcShowValues (FACE_SETTINGS *faceSetting)
 	return update;
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S E T  F A C E  I N T E R V A L                                                                                   *
+ *  ===============================                                                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Set when a face next wants to sample its source, lined up so faces sharing a source sample together.
+ *  \param faceSetting Which face to set.
+ *  \param interval Milliseconds until the next sample, zero if the face has no source.
+ *  \result None.
+ */
+void setFaceInterval (FACE_SETTINGS *faceSetting, int interval)
+{
+	gint64 now = g_get_monotonic_time () / 1000;
+
+	if (interval <= 0)
+		faceSetting -> nextSample = G_MAXINT64;
+	else
+		faceSetting -> nextSample = ((now / interval) + 1) * interval;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  T I C K  W A K E  U P                                                                                             *
+ *  =====================                                                                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Run the tick now rather than waiting for the next face to be due.
+ *  \result None.
+ */
+void tickWakeUp (void)
+{
+	if (inTick)
+		return;
+
+	if (tickSource)
+		g_source_remove (tickSource);
+
+	tickSource = g_timeout_add (0, clockTickCallback, NULL);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  W A K E  F A C E  T Y P E                                                                                         *
+ *  =========================                                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Sample all the faces of one type now, used when a source tells us it has changed.
+ *  \param faceType Type of face to sample.
+ *  \result None.
+ */
+void wakeFaceType (int faceType)
+{
+	int face, faceCount = dialConfig.dialWidth * dialConfig.dialHeight;
+
+	for (face = 0; face < faceCount; ++face)
+	{
+		if (faceSettings[face] && faceSettings[face] -> showFaceType == faceType)
+			faceSettings[face] -> nextSample = 0;
+	}
+	tickWakeUp ();
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  C L O C K  T I C K  C A L L B A C K                                                                               *
@@ -983,14 +1075,18 @@ int calcShowValues (FACE_SETTINGS *faceSetting)
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
- *  \brief The timer when off.
+ *  \brief The timer when off, sample the faces that are due then sleep until the next one is.
  *  \param data Not used.
- *  \result None.
+ *  \result FALSE, the timer is added again for the next deadline.
  */
 gboolean
 clockTickCallback (gpointer data)
 {
 	int update = 0, i, j, face = 0;
+	gint64 now = g_get_monotonic_time () / 1000, nextWake = G_MAXINT64;
+
+	tickSource = 0;
+	inTick = 1;
 
 	for (j = 0; j < dialConfig.dialHeight; j++)
 	{
@@ -1008,7 +1104,11 @@ clockTickCallback (gpointer data)
 					faceSettings[face] -> showFaceType = FACE_TYPE_MAX;
 				}
 			}
-			switch (faceSettings[face] -> showFaceType)
+			if (now < faceSettings[face] -> nextSample && !(faceSettings[face] -> faceFlags & FACE_REDRAW))
+			{
+				;
+			}
+			else switch (faceSettings[face] -> showFaceType)
 			{
 			case FACE_TYPE_CPU_LOAD:
 				readCPUValues (face);
@@ -1052,6 +1152,9 @@ clockTickCallback (gpointer data)
 			case FACE_TYPE_WIFI:
 				readWifiValues (face);
 				break;
+			case FACE_TYPE_PRESSURE:
+				readPressureValues (face);
+				break;
 
 			case FACE_TYPE_MAX:
 			default:
@@ -1067,24 +1170,62 @@ clockTickCallback (gpointer data)
 				faceSettings[face] -> firstValue = 0;
 				break;
 			}
-			update += calcShowValues (faceSettings[face]);
+			/*----------------------------------------------------------------------------------------*
+             * The face may have asked for its own interval, if not use the one for its type          *
+             *----------------------------------------------------------------------------------------*/
+			if (faceSettings[face] -> nextSample <= now)
+			{
+				setFaceInterval (faceSettings[face], gaugeEnabled[faceSettings[face] -> showFaceType].interval);
+			}
+			if (faceSettings[face] -> nextSample < nextWake)
+			{
+				nextWake = faceSettings[face] -> nextSample;
+			}
+			/*----------------------------------------------------------------------------------------*
+             * Only redraw the faces that changed                                                     *
+             *----------------------------------------------------------------------------------------*/
+			if (calcShowValues (faceSettings[face]))
+			{
+				if (dialConfig.drawingArea && lastTime != -1)
+				{
+					gtk_widget_queue_draw_area (dialConfig.drawingArea, i * dialConfig.dialSize, j * dialConfig.dialSize,
+							dialConfig.dialSize, dialConfig.dialSize);
+				}
+				++update;
+			}
 			++face;
 		}
 	}
 	if (lastTime == -1)
-	{
-		++update;
-	}
-	if (update)
 	{
 		if (dialConfig.drawingArea)
 		{
 			gtk_widget_queue_draw (dialConfig.drawingArea);
 		}
+		++update;
+	}
+	if (update)
+	{
 		lastTime = time (NULL);
+
+		/*--------------------------------------------------------------------------------------------*
+         * Hands are still sliding, come back for the next frame                                      *
+         *--------------------------------------------------------------------------------------------*/
+		if (now + 200 < nextWake)
+			nextWake = now + 200;
 	}
 	++sysUpdateID;
-	return TRUE;
+	inTick = 0;
+
+	/*------------------------------------------------------------------------------------------------*
+     * Nothing moving and nothing to sample, do not wake until something asks                         *
+     *------------------------------------------------------------------------------------------------*/
+	if (nextWake != G_MAXINT64)
+	{
+		now = g_get_monotonic_time () / 1000;
+		tickSource = g_timeout_add (nextWake > now ? nextWake - now : 0, clockTickCallback, NULL);
+	}
+	return FALSE;
 }
 
 /**********************************************************************************************************************
@@ -1104,6 +1245,7 @@ gboolean
 focusInEvent (GtkWidget *widget, GdkEventFocus *event, gpointer data)
 {
 	lastTime = -1;
+	tickWakeUp ();
 	weHaveFocus = 1;
 	return TRUE;
 }
@@ -1125,6 +1267,7 @@ gboolean
 focusOutEvent (GtkWidget *widget, GdkEventFocus *event, gpointer data)
 {
 	lastTime = -1;
+	tickWakeUp ();
 	weHaveFocus = 0;
 	return TRUE;
 }
@@ -1177,6 +1320,7 @@ void gaugeReset (int face, int type, int subType)
 	faceSettings[face] -> showFaceType = type;
 	faceSettings[face] -> faceSubType = subType;
 	faceSettings[face] -> nextUpdate = 0;
+	faceSettings[face] -> nextSample = 0;
 	faceSettings[face] -> updateNum = -1;
 
 	setFaceString (faceSettings[face], FACESTR_TIP, 0, "");
@@ -1197,6 +1341,7 @@ void gaugeReset (int face, int type, int subType)
 	configSetIntValue (value, type);
 	sprintf (value, "face_sub_type_%d", face + 1);
 	configSetIntValue (value, subType);
+	tickWakeUp ();
 }
 
 /**********************************************************************************************************************
@@ -1347,6 +1492,26 @@ wifiCallback (guint data)
 	faceSettings[currentFace] -> savedMaxMin.updateInterval = 2;
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  P R E S S U R E  C A L L B A C K                                                                                  *
+ *  ================================                                                                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Called to setup pressure stall dial.
+ *  \param data Which pressure, CPU, memory or I/O.
+ *  \result None.
+ */
+void
+pressureCallback (guint data)
+{
+	gaugeReset (currentFace, FACE_TYPE_PRESSURE, data);
+	faceSettings[currentFace] -> faceFlags |= (FACE_MAX_MIN | FACE_SHOWHOT);
+	faceSettings[currentFace] -> savedMaxMin.maxMinCount = 10;
+	faceSettings[currentFace] -> savedMaxMin.updateInterval = 2;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  E N T R O P Y  C A L L B A C K                                                                                    *
@@ -1684,6 +1849,7 @@ userActive (GtkWidget *widget, GdkEvent* event, gpointer data)
 	{
 		toolTipFace = newFace;
 		lastTime = -1;
+		tickWakeUp ();
 	}
 	return TRUE;
 }
@@ -2089,6 +2255,7 @@ void updateGauge (void)
 	configSetIntValue ("marker_scale", dialConfig.markerScale);
 	configSetValue ("font_name", fontName);
 	lastTime = -1;
+	tickWakeUp ();
 }
 
 /**********************************************************************************************************************
@@ -2443,6 +2610,9 @@ main (int argc, char *argv[])
 		case FACE_TYPE_WIFI:
 			wifiCallback (faceSettings[i] -> faceSubType);
 			break;
+		case FACE_TYPE_PRESSURE:
+			pressureCallback (faceSettings[i] -> faceSubType);
+			break;
 		}
 	}
 	currentFace = saveFace;
@@ -2505,6 +2675,7 @@ main (int argc, char *argv[])
 	readPowerMeterInit();
 	readMoonPhaseInit();
 	readWifiInit();
+	readPressureInit();
 
 	/*------------------------------------------------------------------------------------------------*
      * Called to set any values                                                                       *
@@ -2550,7 +2721,7 @@ main (int argc, char *argv[])
 
 		gtk_window_move (dialConfig.mainWindow, posX, posY);
 	}
-	g_timeout_add (200, clockTickCallback, NULL);
+	tickWakeUp ();
 	dialSetOpacity();
 	prepareForPopup ();
 	createMenu (mainMenuDesc, accelGroup, FALSE);
@@ -34,8 +34,10 @@ extern MENU_DESC gaugeMenuDesc[];
 extern int sysUpdateID;
 
 static int readBatteryDir ();
-static int readBattery (char *filePath);
+static int readBattery ();
 static char *batteryRoot = "/sys/class/power_supply/";
+static char batteryPath[256];
+static SAMPLE_FILE batteryFile = { NULL, -1 };
 
 /**********************************************************************************************************************
  *                                                                                                                    *
@@ -104,14 +106,6 @@ void readBatteryValues (int face)
 	{
 		FACE_SETTINGS *faceSetting = faceSettings[face];
 
-		if (faceSetting -> faceFlags & FACE_REDRAW)
-		{
-			;
-		}
-		else if (sysUpdateID % 25 != 0)
-		{
-			return;
-		}
 		if (myUpdateID != sysUpdateID)
 		{
 			readBatteryDir ();
@@ -154,24 +148,36 @@ void readBatteryValues (int face)
  */
 static int readBatteryDir ()
 {
-	char fullPath[256];
 	struct dirent *dirEntry;
-	DIR *dir = opendir(batteryRoot);
+	DIR *dir;
 
+	/*------------------------------------------------------------------------------------------------*
+     * Keep reading the battery found last time, only search again if it stops working                *
+     *------------------------------------------------------------------------------------------------*/
 	currentState.readBat = 0;
-	if (dir)
+	if (batteryFile.fileName != NULL)
+	{
+		if (readBattery ())
+			return currentState.readBat;
+		samplerClose (&batteryFile);
+		batteryFile.fileName = NULL;
+	}
+	if ((dir = opendir(batteryRoot)) != NULL)
 	{
 		while ((dirEntry = readdir(dir)) != NULL)
 		{
 			if (strncmp (dirEntry -> d_name, "BAT", 3) == 0)
 			{
-				strcpy (fullPath, batteryRoot);
-				strcat (fullPath, dirEntry -> d_name);
-				strcat (fullPath, "/");
-				if (readBattery (fullPath))
+				strcpy (batteryPath, batteryRoot);
+				strcat (batteryPath, dirEntry -> d_name);
+				strcat (batteryPath, "/uevent");
+				batteryFile.fileName = batteryPath;
+				if (readBattery ())
 				{
 					break;
 				}
+				samplerClose (&batteryFile);
+				batteryFile.fileName = NULL;
 			}
 		}
 		closedir (dir);
@@ -215,20 +221,16 @@ char *copyNoCtrl (char *outStr, char *inStr, int maxSize)
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
- *  \brief Read from proc the state of the battery.
- *  \param filePath Path of the battery state directory.
+ *  \brief Read from proc the state of the battery, the uevent file is kept open between reads.
  *  \result Number of values read.
  */
-static int readBattery (char *filePath)
+static int readBattery ()
 {
-	FILE *inFile;
-	char fullName[256];
+	char fullName[256], *ptr;
 
-	strcpy (fullName, filePath);
-	strcat (fullName, "uevent");
-	if ((inFile = fopen (fullName, "r")) != NULL)
+	if ((ptr = samplerRead (&batteryFile)) != NULL)
 	{
-		while (fgets (fullName, 255, inFile))
+		while (samplerGetLine (&ptr, fullName, 255))
 		{
 			int i = 0;
 			while (matchStrings[i] != NULL)
@@ -265,7 +267,6 @@ static int readBattery (char *filePath)
 				++i;
 			}
 		}
-		fclose (inFile);
 	}
 	return currentState.readBat;
 }
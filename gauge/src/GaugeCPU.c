@@ -22,7 +22,10 @@
  *  \brief Calculate the CPU usage for the gauge.
  */
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "GaugeDisp.h"
 
 #define CPU_COUNT 32
@@ -46,6 +49,19 @@ static int loadValues[CPU_COUNT + 1][8];
 static unsigned long long startStats[CPU_COUNT + 1][10];
 static unsigned long long endStats[CPU_COUNT + 1][10];
 static int cpuCount = 0;
+
+/**********************************************************************************************************************
+ * /proc/stat is read once a tick into a snapshot of every CPU, the files are kept open between reads.                *
+ **********************************************************************************************************************/
+static SAMPLE_FILE statFile = { "/proc/stat", -1 };
+static int statSnapshotID = -1;
+static int statWords[CPU_COUNT + 1];
+static unsigned long long statSnapshot[CPU_COUNT + 1][10];
+static int freqFiles[CPU_COUNT];
+static int freqFileCount = -1;
+static int freqUpdateID = -1;
+static int freqCount;
+static SAMPLE_FILE loadAvgFile = { "/proc/loadavg", -1 };
 char *name[8] =
 {
 	__("Total"),
@@ -113,8 +129,7 @@ void readCPUValues (int face)
 
 		if (faceType == 0x0F)
 		{
-			if (!update && sysUpdateID % 5 != 0)
-				return;
+			setFaceInterval (faceSetting, 1000);
 
 			setFaceString (faceSetting, FACESTR_TOP, 0, _("Load\nAverage"));
 			setFaceString (faceSetting, FACESTR_WIN, 0, _("Load average - Gauge"));
@@ -144,8 +159,7 @@ void readCPUValues (int face)
 		}
 		else if (faceType == 0x0E)
 		{
-			if (!update && sysUpdateID % 5 != 0)
-				return;
+			setFaceInterval (faceSetting, 1000);
 
 			int max = -1, min = -1;
 			strcpy (cpuName, _("Average"));
@@ -171,9 +185,6 @@ void readCPUValues (int face)
 		}
 		else
 		{
-			if (!update && sysUpdateID % 2 != 0)
-				return;
-
 			strcpy (cpuName, _("CPU"));
 			if (procNumber)
 			{
@@ -252,70 +263,80 @@ void readCPULoad (int procNumber)
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- *  R E A D  S T A T S                                                                                                *
- *  ==================                                                                                                *
+ *  R E A D  S T A T  S N A P S H O T                                                                                 *
+ *  =================================                                                                                 *
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
- *  \brief Open the /proc/stat file and read the CPU status.
- *  \param stats Where to read the stats to.
- *  \param procNumber Which processor to read from.
- *  \result Number of words read.
+ *  \brief Read the whole of /proc/stat in one go and split out the lines for every CPU.
+ *  \result Number of CPU lines found.
  */
-int readStats (unsigned long long *stats, int procNumber)
+static int readStatSnapshot (void)
 {
-	int i, j, n = 0, found = 0;
-	char readBuff[1025], word[254], procName[41];
-	FILE *inCPUFile = fopen ("/proc/stat", "r");
+	int i, n, found = 0;
+	char *ptr = samplerRead (&statFile);
 
-	strcpy (procName, "cpu");
-	if (procNumber) sprintf (&procName[3], "%d", procNumber - 1);
-
-	while (inCPUFile != NULL && !found)
+	memset (statWords, 0, sizeof (statWords));
+	while (ptr != NULL && samplerMatch (ptr, "cpu"))
 	{
-		word[i = j = n = 0] = 0;
-		if (!fgets (readBuff, 1024, inCPUFile))
-			break;
+		int procNumber = 0;
+
+		ptr += 3;
+		if (*ptr >= '0' && *ptr <= '9')
+			procNumber = (int)samplerReadNumber (&ptr) + 1;
 
-		while (n < 9)
+		if (procNumber <= CPU_COUNT)
 		{
-			if (readBuff[i] == ' ' || readBuff[i] == 0)
+			unsigned long long *stats = &statSnapshot[procNumber][0];
+
+			stats[0] = 0;
+			for (n = 1; n < 9; ++n)
 			{
-				if (word[0] != 0)
-				{
-					if (n == 0)
-					{
-						if (strcmp (word, procName) != 0)
-							break;
-						pickCPUMenuDesc[procNumber].disable = 0;
-						stats[0] = 0;
-						found = 1;
-					}
-					else
-					{
-						stats[n] = atoll (word);
-						if (n != 4)					/* Ignore Idle ticks */
-							stats[0] += stats[n];	/* Count all other ticks */
-					}
-					word[j = 0] = 0;
-					n ++;
-				}
-				if (readBuff[i] == 0)
+				while (*ptr == ' ')
+					++ptr;
+				if (*ptr < '0' || *ptr > '9')
 					break;
+				stats[n] = samplerReadNumber (&ptr);
+				if (n != 4)					/* Ignore Idle ticks */
+					stats[0] += stats[n];	/* Count all other ticks */
 			}
-			else
-			{
-				word[j++] = readBuff[i];
-				word[j] = 0;
-			}
-			i ++;
+			statWords[procNumber] = n;
+			++found;
 		}
+		ptr = samplerNextLine (ptr);
 	}
-	if (inCPUFile != NULL)
+	for (i = 0; i < CPU_COUNT; ++i)
 	{
-		fclose (inCPUFile);
+		if (statWords[i])
+			pickCPUMenuDesc[i].disable = 0;
 	}
-	return n;
+	statSnapshotID = sysUpdateID;
+	return found;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  S T A T S                                                                                                *
+ *  ==================                                                                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Get the CPU status from the snapshot of /proc/stat, reading it if it is from an earlier tick.
+ *  \param stats Where to read the stats to.
+ *  \param procNumber Which processor to read from.
+ *  \result Number of words read.
+ */
+int readStats (unsigned long long *stats, int procNumber)
+{
+	int i;
+
+	if (statSnapshotID != sysUpdateID)
+		readStatSnapshot ();
+
+	for (i = 0; i < statWords[procNumber]; ++i)
+		stats[i] = statSnapshot[procNumber][i];
+
+	return statWords[procNumber];
 }
 
 /**********************************************************************************************************************
@@ -332,14 +353,23 @@ int readStats (unsigned long long *stats, int procNumber)
 int readAverage (float readAvs[])
 {
 	int retn = 0;
-	FILE *readFile = fopen ("/proc/loadavg", "r");
+	char *ptr = samplerRead (&loadAvgFile);
 
-	if (readFile != NULL)
+	if (ptr != NULL)
 	{
-		retn = fscanf (readFile, "%f %f %f %d/%d %d",
-				&readAvs[0], &readAvs[1], &readAvs[2],
-				&readCount[0], &readCount[1], &readCount[2]);
-		fclose (readFile);
+		/*--------------------------------------------------------------------------------------------*
+         * Format is: 0.52 0.58 0.59 1/234 5678                                                       *
+         *--------------------------------------------------------------------------------------------*/
+		for (retn = 0; retn < 3; ++retn)
+			readAvs[retn] = samplerReadFloat (&ptr);
+		readCount[0] = (int)samplerReadNumber (&ptr);
+		if (*ptr == '/')
+		{
+			++ptr;
+			readCount[1] = (int)samplerReadNumber (&ptr);
+			readCount[2] = (int)samplerReadNumber (&ptr);
+			retn = 6;
+		}
 	}
 	return retn;
 }
@@ -351,49 +381,56 @@ int readAverage (float readAvs[])
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
- *  \brief Read the cpuinfo clock speed.
+ *  \brief Read the cpufreq clock speed, the files are opened once and read at most once a tick.
  *  \result None.
  */
 int readClockRates (int *maxPtr, int *minPtr)
 {
-	int i = 0, retn = 0;
-	char readBuff[512];
-	FILE *readFile;
+	int i = 0, n;
+	char readBuff[81];
 
-	cpuCount = 0;
-	clockRates[0] = 0;
-	for (i = 0; i < CPU_COUNT; ++i)
+	if (freqFileCount == -1)
+	{
+		for (freqFileCount = 0; freqFileCount < CPU_COUNT; ++freqFileCount)
+		{
+			sprintf (readBuff, "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq", freqFileCount);
+			if ((freqFiles[freqFileCount] = open (readBuff, O_RDONLY | O_CLOEXEC)) == -1)
+				break;
+		}
+	}
+	if (freqUpdateID != sysUpdateID)
 	{
-		sprintf (readBuff, "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq", i);
-		if ((readFile = fopen (readBuff, "r")) != NULL)
+		freqCount = 0;
+		clockRates[0] = 0;
+		for (i = 0; i < freqFileCount; ++i)
 		{
-			++cpuCount;
-			if (fgets(readBuff, 510, readFile))
+			if ((n = pread (freqFiles[i], readBuff, 80, 0)) > 0)
 			{
-				int val = atoi (readBuff) / 1000;
-
-				if (maxPtr != NULL)
-				{
-					if (val > *maxPtr || *maxPtr == -1)
-						*maxPtr = val;
-				}
-				if (minPtr != NULL)
-				{
-					if (val < *minPtr || *minPtr == -1)
-						*minPtr = val;
-				}
-				clockRates[++retn] = val;;
-				clockRates[0] += clockRates[retn];
+				readBuff[n] = 0;
+				clockRates[++freqCount] = atoi (readBuff) / 1000;
+				clockRates[0] += clockRates[freqCount];
 			}
-			fclose (readFile);
-			continue;
 		}
-		break;
+		if (freqCount)
+		{
+			clockRates[0] /= freqCount;
+		}
+		freqUpdateID = sysUpdateID;
 	}
-	if (retn)
+	cpuCount = freqFileCount;
+
+	for (i = 1; i <= freqCount; ++i)
 	{
-		clockRates[0] /= retn;
+		if (maxPtr != NULL)
+		{
+			if (clockRates[i] > *maxPtr || *maxPtr == -1)
+				*maxPtr = clockRates[i];
+		}
+		if (minPtr != NULL)
+		{
+			if (clockRates[i] < *minPtr || *minPtr == -1)
+				*minPtr = clockRates[i];
+		}
 	}
-	return retn;
+	return freqCount;
 }
-
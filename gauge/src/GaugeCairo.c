@@ -82,42 +82,65 @@ drawFace (cairo_t *cr, int face, int posX, int posY, char circ)
 {
 	int i, maxVal, minVal, col;
 	FACE_SETTINGS *faceSetting = faceSettings[face];
+	char faceKey[81];
 
 	/*------------------------------------------------------------------------------------------------*
-     * Draw the face, it is made up of 3 overlapping circles                                          *
+     * Only the hands and text change every tick, the rest of the face is kept in a cache             *
      *------------------------------------------------------------------------------------------------*/
-	dialDrawStart (cr, posX, posY);
-
 	col = (weHaveFocus && face == currentFace) ? FACE3_COLOUR : FACE4_COLOUR;
-	if (circ)
-	{
-		dialCircleGradient (64, col, 1);
-/*      dialDrawCircle (64, col, -1); */
-	}
-	else
+	sprintf (faceKey, "%d:%d:%g:%g", col, faceSetting -> faceFlags & (FACE_SHOWHOT | FACE_SHOWCOLD | FACE_HC_REVS),
+			faceSetting -> faceScaleMin, faceSetting -> faceScaleMax);
+
+	if (!dialDrawStartCached (cr, posX, posY, circ ? -1 : face, faceKey))
 	{
-		dialSquareGradient (64, col, 1);
-/*      dialDrawSquare (64, col, -1); */
-	}
+		/*--------------------------------------------------------------------------------------------*
+         * Draw the face, it is made up of 3 overlapping circles                                      *
+         *--------------------------------------------------------------------------------------------*/
+		if (circ)
+		{
+			dialCircleGradient (64, col, 1);
+/*          dialDrawCircle (64, col, -1); */
+		}
+		else
+		{
+			dialSquareGradient (64, col, 1);
+/*          dialDrawSquare (64, col, -1); */
+		}
 
-	dialCircleGradient (62, FACE2_COLOUR, 0);
-	dialCircleGradient (58, FACE1_COLOUR, 1);
+		dialCircleGradient (62, FACE2_COLOUR, 0);
+		dialCircleGradient (58, FACE1_COLOUR, 1);
 
-/*  dialDrawCircle (62, FACE3_COLOUR, -1); */
-/*  dialDrawCircle (60, FACE4_COLOUR, -1); */
+/*      dialDrawCircle (62, FACE3_COLOUR, -1); */
+/*      dialDrawCircle (60, FACE4_COLOUR, -1); */
 
-	/*------------------------------------------------------------------------------------------------*
-     * Draw the hot and cold markers                                                                  *
-     *------------------------------------------------------------------------------------------------*/
-	if (faceSetting -> faceFlags & FACE_SHOWHOT)
-	{
-		col = (faceSetting -> faceFlags & FACE_HC_REVS) ? COLD__COLOUR : HOT___COLOUR;
-		dialHotCold (54, col, 0);
-	}
-	if (faceSetting -> faceFlags & FACE_SHOWCOLD)
-	{
-		col = (faceSetting -> faceFlags & FACE_HC_REVS) ? HOT___COLOUR : COLD__COLOUR;
-		dialHotCold (54, col, 1);
+		/*--------------------------------------------------------------------------------------------*
+         * Draw the hot and cold markers                                                              *
+         *--------------------------------------------------------------------------------------------*/
+		if (faceSetting -> faceFlags & FACE_SHOWHOT)
+		{
+			col = (faceSetting -> faceFlags & FACE_HC_REVS) ? COLD__COLOUR : HOT___COLOUR;
+			dialHotCold (54, col, 0);
+		}
+		if (faceSetting -> faceFlags & FACE_SHOWCOLD)
+		{
+			col = (faceSetting -> faceFlags & FACE_HC_REVS) ? HOT___COLOUR : COLD__COLOUR;
+			dialHotCold (54, col, 1);
+		}
+
+		/*--------------------------------------------------------------------------------------------*
+         * Draw the hour markers                                                                      *
+         *--------------------------------------------------------------------------------------------*/
+		for (i = 0; i <= 10 ; ++i)
+		{
+			char tempBuff[15];
+			int markAngle = i * 90;
+			float scale = ((faceSetting -> faceScaleMax - faceSetting -> faceScaleMin) * i) / 10;
+
+			sprintf (tempBuff, "%0.3f", scale + faceSetting -> faceScaleMin);
+			dialDrawMark (markAngle, 29, QMARK_COLOUR, QMARK_COLOUR, removeExtra (tempBuff));
+			dialDrawMinute (29, 1, markAngle, HMARK_COLOUR);
+		}
+		dialDrawCacheDone ();
 	}
 
 	/*------------------------------------------------------------------------------------------------*
@@ -128,20 +151,6 @@ drawFace (cairo_t *cr, int face, int posX, int posY, char circ)
 	if (faceSetting -> text[FACESTR_BOT])
 		dialDrawText (1, faceSetting -> text[FACESTR_BOT], TEXT__COLOUR);
 
-	/*------------------------------------------------------------------------------------------------*
-     * Draw the hour markers                                                                          *
-     *------------------------------------------------------------------------------------------------*/
-	for (i = 0; i <= 10 ; ++i)
-	{
-		char tempBuff[15];
-		int markAngle = i * 90;
-		float scale = ((faceSetting -> faceScaleMax - faceSetting -> faceScaleMin) * i) / 10;
-
-		sprintf (tempBuff, "%0.3f", scale + faceSetting -> faceScaleMin);
-		dialDrawMark (markAngle, 29, QMARK_COLOUR, QMARK_COLOUR, removeExtra (tempBuff));
-		dialDrawMinute (29, 1, markAngle, HMARK_COLOUR);
-	}
-
 	/*------------------------------------------------------------------------------------------------*
      * Draw the hands                                                                                 *
      *------------------------------------------------------------------------------------------------*/
@@ -177,13 +186,22 @@ drawFace (cairo_t *cr, int face, int posX, int posY, char circ)
  */
 void clockExpose (cairo_t *cr)
 {
-	int i, j, face = 0;
+	int i, j, face = 0, dialSize = dialConfig.dialSize;
+	double clipX1, clipY1, clipX2, clipY2;
+
+	/*------------------------------------------------------------------------------------------------*
+     * Skip any faces that are outside the area being redrawn                                         *
+     *------------------------------------------------------------------------------------------------*/
+	cairo_clip_extents (cr, &clipX1, &clipY1, &clipX2, &clipY2);
 
 	for (j = 0; j < dialConfig.dialHeight; j++)
 	{
 		for (i = 0; i < dialConfig.dialWidth; i++)
 		{
-			drawFace (cr, face, (i * dialConfig.dialSize), (j * dialConfig.dialSize), 0);
+			if ((i + 1) * dialSize > clipX1 && i * dialSize < clipX2 && (j + 1) * dialSize > clipY1 && j * dialSize < clipY2)
+			{
+				drawFace (cr, face, (i * dialSize), (j * dialSize), 0);
+			}
 			if (face == currentFace)
 			{
 				if (faceSettings[face] -> text[FACESTR_WIN])
@@ -31,6 +31,7 @@
 #include <string.h>
 #include <unistd.h>
 #include <locale.h>
+#include <pthread.h>
 #include <sys/time.h>
 #include <time.h>
 #include <gdk/gdk.h>
@@ -104,11 +105,12 @@
 #define MENU_GAUGE_MOONPHASE	5
 #define MENU_GAUGE_NETWORK		6
 #define MENU_GAUGE_POWER		7
-#define MENU_GAUGE_SENSOR		8
-#define MENU_GAUGE_THERMO		9
-#define MENU_GAUGE_TIDE			10
-#define MENU_GAUGE_WEATHER		11
-#define MENU_GAUGE_WIFI			12
+#define MENU_GAUGE_PRESSURE		8
+#define MENU_GAUGE_SENSOR		9
+#define MENU_GAUGE_THERMO		10
+#define MENU_GAUGE_TIDE			11
+#define MENU_GAUGE_WEATHER		12
+#define MENU_GAUGE_WIFI			13
 
 #define MENU_PREF_ONTOP			0
 #define MENU_PREF_STUCK			1
@@ -161,6 +163,7 @@ typedef struct _faceSettings
 	unsigned int faceSubType;
 	short int nextUpdate;
 	short int updateNum;
+	gint64 nextSample;
 	char  *text[FACESTR_COUNT];
 	short textSize[FACESTR_COUNT];
 	float firstValue;
@@ -188,15 +191,53 @@ FACE_SETTINGS;
 #define FACE_TYPE_MOONPHASE		12
 #define FACE_TYPE_WIFI			13
 #define FACE_TYPE_SENSOR_INPUT	14
-#define FACE_TYPE_MAX			15
+#define FACE_TYPE_PRESSURE		15
+#define FACE_TYPE_MAX			16
 
 typedef struct _gaugeEnabled 
 {
 	char *gaugeName;
 	int enabled;
+	int interval;
 }
 GAUGE_ENABLED;
 
+/*----------------------------------------------------------------------------------------------------*
+ * A /proc or /sys file kept open by the sampler, set fileHandle to -1 before the first read.         *
+ *----------------------------------------------------------------------------------------------------*/
+typedef struct _sampleFile
+{
+	char *fileName;
+	int fileHandle;
+	int readID;
+	int readSize;
+	int bufferSize;
+	char *buffer;
+}
+SAMPLE_FILE;
+
+/*----------------------------------------------------------------------------------------------------*
+ * A source that can block (statvfs, running a program) is sampled on its own thread.                 *
+ *----------------------------------------------------------------------------------------------------*/
+#define SAMPLE_NONE		0
+#define SAMPLE_FRESH	1
+#define SAMPLE_STALE	2
+
+typedef struct _sampleJob
+{
+	void (*sampleFunc) (void *snapshot);
+	int snapshotSize;
+	int interval;
+	int timeout;
+	pthread_t threadHandle;
+	unsigned int sequence;
+	long long startedAt;
+	long long doneAt;
+	void *snapshot;
+	void *working;
+}
+SAMPLE_JOB;
+
 #define LOCATION_COUNT			6
 
 /*----------------------------------------------------------------------------------------------------*
@@ -222,6 +263,7 @@ void harddiskCallback		(guint data);
 void batteryCallback		(guint data);
 void moonPhaseCallback		(guint data);
 void wifiCallback			(guint data);
+void pressureCallback		(guint data);
 void entropyCallback		(guint data);
 void tideCallback			(guint data);
 void sensorTempCallback		(guint data);
@@ -247,6 +289,9 @@ char *getStringValue (char *outString1, char *outString2, int maxSize, int strin
 int xSinCos (int number, int angle, int useCos);
 void maxMinReset (SAVED_MAX_MIN *savedMaxMin, int count, int interval);
 void setFaceString (FACE_SETTINGS *faceSetting, int str, int shorten, char *format, ...);
+void setFaceInterval (FACE_SETTINGS *faceSetting, int interval);
+void tickWakeUp (void);
+void wakeFaceType (int faceType);
 
 void readCPUInit (void);
 void readCPUValues (int face);
@@ -262,6 +307,8 @@ void readMoonPhaseInit (void);
 void readMoonPhaseValues (int face);
 void readWifiInit (void);
 void readWifiValues (int face);
+void readPressureInit (void);
+void readPressureValues (int face);
 void readEntropyInit (void);
 void readEntropyValues (int face);
 void readTideInit (void);
@@ -276,3 +323,14 @@ void readPowerMeterInit (void);
 void readPowerMeterValues (int face);
 void weatherGetMaxMin (FACE_SETTINGS *faceSetting);
 
+char *samplerRead (SAMPLE_FILE *sampleFile);
+void samplerClose (SAMPLE_FILE *sampleFile);
+void samplerExpire (SAMPLE_FILE *sampleFile);
+char *samplerNextLine (char *ptr);
+char *samplerGetLine (char **ptr, char *line, int maxLen);
+int samplerMatch (char *ptr, char *prefix);
+long long samplerReadNumber (char **ptr);
+float samplerReadFloat (char **ptr);
+SAMPLE_JOB *samplerStartJob (void (*sampleFunc) (void *snapshot), int snapshotSize, int interval, int timeout);
+int samplerGetSnapshot (SAMPLE_JOB *job, void *snapshot);
+
@@ -32,9 +32,9 @@ extern GAUGE_ENABLED gaugeEnabled[];
 extern MENU_DESC gaugeMenuDesc[];
 extern int sysUpdateID;
 
-static int readEntropyFile (char *fileName, int defValue);
+static int readEntropyFile (SAMPLE_FILE *sampleFile, int defValue);
 /* static char *entropyPoolFile = "/proc/sys/kernel/random/poolsize"; */
-static char *entropyAvailFile = "/proc/sys/kernel/random/entropy_avail";
+static SAMPLE_FILE entropyAvailFile = { "/proc/sys/kernel/random/entropy_avail", -1 };
 static int myUpdateID = 100;
 static int myPoolsize = 4096;
 static int myEntropyAvail = 0;
@@ -74,17 +74,9 @@ void readEntropyValues (int face)
 	{
 		FACE_SETTINGS *faceSetting = faceSettings[face];
 
-		if (faceSetting -> faceFlags & FACE_REDRAW)
-		{
-			;
-		}
-		else if (sysUpdateID % 5 != 0)
-		{
-			return;
-		}
 		if (myUpdateID != sysUpdateID)
 		{
-			myEntropyAvail = readEntropyFile (entropyAvailFile, myEntropyAvail);
+			myEntropyAvail = readEntropyFile (&entropyAvailFile, myEntropyAvail);
 			myUpdateID = sysUpdateID;
 		}
 		faceSetting -> firstValue = myEntropyAvail * 100;
@@ -104,22 +96,17 @@ void readEntropyValues (int face)
  **********************************************************************************************************************/
 /**
  *  \brief Read a value from a file.
- *  \param filename Name of the file to read .
+ *  \param sampleFile File to read, kept open between reads.
  *  \param defValue Default value if the file could not be read.
  *  \result Value read from the file.
  */
-static int readEntropyFile (char *filename, int defValue)
+static int readEntropyFile (SAMPLE_FILE *sampleFile, int defValue)
 {
-	int valRead = defValue;
-	FILE *inFile = fopen (filename, "r");
+	char *ptr = samplerRead (sampleFile);
 
-	if (inFile != NULL)
-	{
-		char readBuff[81];
-		if (fgets (readBuff, 80, inFile))
-			valRead = atoi (readBuff);
-		fclose (inFile);
-	}
-	return valRead;
+	if (ptr != NULL)
+		return (int)samplerReadNumber (&ptr);
+
+	return defValue;
 }
 
@@ -22,15 +22,21 @@
  *  \brief Create gauges for hard disk info.
  */
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <time.h>
 #include <sys/statvfs.h>
 #include <dialsys.h>
 
 #include "GaugeDisp.h"
 
 #define MAX_PARTITIONS	20
-#define MAX_DISKS		20
+#define MAX_DISK_SLOTS	10
 #define MAX_SCALE_MEM	20
+#define DISK_VALUES		5
+#define LOCAL_SPACE_TTL	10000
+#define NET_SPACE_TTL	60000
 
 extern FACE_SETTINGS *faceSettings[];
 extern GAUGE_ENABLED gaugeEnabled[];
@@ -42,16 +48,33 @@ extern int sysUpdateID;
 struct diskValues
 {
 	float rate;
-	unsigned long long value;
 	int useScale;
 	int oldScales[MAX_SCALE_MEM];
 };
 
+struct diskCounters
+{
+	unsigned long long reads;
+	unsigned long long readSectors;
+	unsigned long long readTicks;
+	unsigned long long writes;
+	unsigned long long writeSectors;
+	unsigned long long writeTicks;
+	unsigned long long queueTicks;
+};
+
 typedef struct _diskInfo
 {
 	char name[41];
-	struct diskValues secRead;
-	struct diskValues secWrite;
+	unsigned int major;
+	unsigned int minor;
+	int blockSize;
+	int isPartition;
+	int seenID;
+	int menuSlot;
+	struct diskCounters counters;
+	struct diskValues values[DISK_VALUES];
+	struct _diskInfo *next;
 }
 DISK_INFO;
 
@@ -59,23 +82,59 @@ typedef struct _partInfo
 {
 	char diskName[81];
 	char tidyName[41];
+	int mounted;
+	int network;
+	int seenID;
+	unsigned int mountID;
 }
 PARTITION_INFO;
 
+typedef struct _partSpace
+{
+	float percent;
+	unsigned long long total;
+	unsigned long long used;
+	unsigned int mountID;
+	gint64 expires;
+}
+PART_SPACE;
+
 static int myUpdateID = 100;
-static long lastTime;
+static int seenID;
+static long long lastTime;
 static char *diskTypes[] = { "ext2","ext3","ext4","btrfs","xfs","cifs","nfs","usbfs","vfat","fuseblk",NULL };
-static char *diskInfo = "/proc/mounts"; /* /etc/fstab */
-static char *diskStats = "/proc/diskstats";
-static char *typeNames[] = { "Reads", "Writes" };
+static char *netTypes[] = { "cifs","nfs",NULL };
+static char *mountInfo = "/proc/self/mounts"; /* /etc/fstab */
+static SAMPLE_FILE diskStats = { "/proc/diskstats", -1 };
+static char *typeNames[] = { "Reads", "Writes", "IOPS", "Queue Depth", "Await" };
+
+/*----------------------------------------------------------------------------------------------------*
+ * Every disk is kept in a hash keyed on major:minor, only the first few get a slot in the menu.      *
+ *----------------------------------------------------------------------------------------------------*/
+static DISK_INFO **diskHash;
+static int diskHashSize;
+static int diskCount;
+static DISK_INFO allDisks = { "All" };
+static DISK_INFO noDisk = { "" };
+static DISK_INFO *diskSlots[MAX_DISK_SLOTS + 1] = { &allDisks };
+
+/*----------------------------------------------------------------------------------------------------*
+ * A slot keeps its place when the mount goes away so faces and menus do not move, statvfs can hang   *
+ * on a network mount so network and local mounts are read by different sampler threads.             *
+ *----------------------------------------------------------------------------------------------------*/
+static PARTITION_INFO partitions[MAX_PARTITIONS];
+static int partitionCount;
+static unsigned int nextMountID;
+static pthread_mutex_t partitionLock = PTHREAD_MUTEX_INITIALIZER;
+static SAMPLE_JOB *spaceJobs[2];
 
-void *diskActivity;
-void *partitionInfo;
+static void readLocalSpace (void *snapshot);
+static void readNetworkSpace (void *snapshot);
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- *  P A R T  Q U E U E  C O M P                                                                                       *
- *  ===========================                                                                                       *
+ *  P A R T  S O R T  C O M P                                                                                         *
+ *  =========================                                                                                         *
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
@@ -84,32 +143,13 @@ void *partitionInfo;
  *  \param item2 Second Item.
  *  \result Result of compare.
  */
-int partQueueComp (void *item1, void *item2)
+static int partSortComp (const void *item1, const void *item2)
 {
-	PARTITION_INFO *partOne = (PARTITION_INFO *)item1;
-	PARTITION_INFO *partTwo = (PARTITION_INFO *)item2;
+	const PARTITION_INFO *partOne = (const PARTITION_INFO *)item1;
+	const PARTITION_INFO *partTwo = (const PARTITION_INFO *)item2;
 	return strcmp (partOne -> tidyName, partTwo -> tidyName);
 }
 
-/**********************************************************************************************************************
- *                                                                                                                    *
- *  D I S K  Q U E U E  C O M P                                                                                       *
- *  ===========================                                                                                       *
- *                                                                                                                    *
- **********************************************************************************************************************/
-/**
- *  \brief Compare two disk names.
- *  \param item1 First item.
- *  \param item2 Second Item.
- *  \result Result of compare.
- */
-int diskQueueComp (void *item1, void *item2)
-{
-	DISK_INFO *diskOne = (DISK_INFO *)item1;
-	DISK_INFO *diskTwo = (DISK_INFO *)item2;
-	return strcmp (diskOne -> name, diskTwo -> name);
-}
-
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  T I D Y  P A R T I T I O N  N A M E                                                                               *
@@ -142,6 +182,93 @@ void tidyPartitionName (PARTITION_INFO *partInfo)
 		strcpy (partInfo -> tidyName, "root");
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S T A R T  S P A C E  J O B S                                                                                     *
+ *  =============================                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Start the threads that read the free space once there is a mount for them.
+ *  \result None.
+ */
+static void startSpaceJobs (void)
+{
+	int i, network;
+
+	for (i = 0; i < partitionCount; ++i)
+	{
+		network = partitions[i].network;
+		if (partitions[i].mounted && spaceJobs[network] == NULL)
+		{
+			/*----------------------------------------------------------------------------------------*
+             * A stuck network mount is reported sooner than a busy local disk                        *
+             *----------------------------------------------------------------------------------------*/
+			if (network)
+				spaceJobs[network] = samplerStartJob (readNetworkSpace, sizeof (PART_SPACE) * MAX_PARTITIONS, 2000, 10000);
+			else
+				spaceJobs[network] = samplerStartJob (readLocalSpace, sizeof (PART_SPACE) * MAX_PARTITIONS, 2000, 30000);
+		}
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  M E R G E  P A R T I T I O N S                                                                                    *
+ *  ==============================                                                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Fit the mounts just read in to the slots, new mounts take a free slot, gone mounts keep theirs.
+ *  \param found Sorted list of mounts just read.
+ *  \param count Number of mounts in the list.
+ *  \result None.
+ */
+static void mergePartitions (PARTITION_INFO *found, int count)
+{
+	static int seenID = 0;
+	int i, j;
+
+	++seenID;
+	pthread_mutex_lock (&partitionLock);
+	for (i = 0; i < count; ++i)
+	{
+		for (j = 0; j < partitionCount; ++j)
+		{
+			if (strcmp (partitions[j].diskName, found[i].diskName) == 0)
+				break;
+		}
+		if (j == partitionCount)
+		{
+			if (partitionCount < MAX_PARTITIONS)
+				++partitionCount;
+			else
+			{
+				for (j = 0; j < partitionCount; ++j)
+				{
+					if (!partitions[j].mounted && partitions[j].seenID != seenID)
+						break;
+				}
+				if (j == partitionCount)
+					continue;
+			}
+		}
+		if (!partitions[j].mounted)
+		{
+			partitions[j] = found[i];
+			partitions[j].mounted = 1;
+			partitions[j].mountID = ++nextMountID;
+		}
+		partitions[j].seenID = seenID;
+	}
+	for (j = 0; j < partitionCount; ++j)
+	{
+		if (partitions[j].seenID != seenID)
+			partitions[j].mounted = 0;
+	}
+	pthread_mutex_unlock (&partitionLock);
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  R E A D  P A R T I T I O N  N A M E S                                                                             *
@@ -149,16 +276,17 @@ void tidyPartitionName (PARTITION_INFO *partInfo)
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
- *  \brief Read the partition names from the system.
+ *  \brief Read the partition names from the system, called at the start and when the mounts change.
  *  \result None.
  */
 void readPartitionNames()
 {
 	FILE *fstab;
 	char readBuff[256], readWord[256];
+	PARTITION_INFO found[MAX_PARTITIONS];
 	int disk = 0, menu = 0;
 
-	if ((fstab = fopen (diskInfo, "r")) != NULL)
+	if ((fstab = fopen (mountInfo, "r")) != NULL)
 	{
 		while (fgets (readBuff, 255, fstab) && disk < MAX_PARTITIONS)
 		{
@@ -198,11 +326,15 @@ void readPartitionNames()
 						{
 							if (strcmp (readWord, diskTypes[j]) == 0)
 							{
-								PARTITION_INFO *partInfo = (PARTITION_INFO *)malloc (sizeof (PARTITION_INFO));
+								PARTITION_INFO *partInfo = &found[disk];
 								memset (partInfo, 0, sizeof (PARTITION_INFO));
 								strcpy (partInfo -> diskName, diskName);
 								tidyPartitionName (partInfo);
-								queuePutSort (partitionInfo, partInfo, partQueueComp);
+								for (j = 0; netTypes[j]; ++j)
+								{
+									if (strcmp (readWord, netTypes[j]) == 0)
+										partInfo -> network = 1;
+								}
 								++disk;
 								break;
 							}
@@ -214,21 +346,46 @@ void readPartitionNames()
 				++i;
 			}
 		}
-		while (menu < disk)
+		fclose (fstab);
+
+		qsort (found, disk, sizeof (PARTITION_INFO), partSortComp);
+		mergePartitions (found, disk);
+		startSpaceJobs ();
+
+		/*--------------------------------------------------------------------------------------------*
+         * Slots are used in order so the first one never used ends the menu                          *
+         *--------------------------------------------------------------------------------------------*/
+		for (menu = 0; spaceMenuDesc[menu].funcCallBack != NULL; ++menu)
 		{
-			PARTITION_INFO *partInfo = queueRead (partitionInfo, menu);
-			if (partInfo != NULL)
+			if (menu < partitionCount)
 			{
-				spaceMenuDesc[menu].disable = 0;
-				spaceMenuDesc[menu].menuName = partInfo -> tidyName;
+				spaceMenuDesc[menu].disable = partitions[menu].mounted ? 0 : 1;
+				spaceMenuDesc[menu].menuName = partitions[menu].tidyName;
 				gaugeMenuDesc[MENU_GAUGE_HARDDISK].disable = 0;
 			}
-			++menu;
 		}
-		fclose (fstab);
 	}
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  M O U N T S  C H A N G E D                                                                                        *
+ *  ==========================                                                                                        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Called from the main loop when the kernel flags a change to the mount table.
+ *  \param source Channel on the mount table.
+ *  \param condition What woke us up.
+ *  \param data Not used.
+ *  \result TRUE to keep watching.
+ */
+static gboolean mountsChanged (GIOChannel *source, GIOCondition condition, gpointer data)
+{
+	readPartitionNames ();
+	return TRUE;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  G E T  P A R T I T I O N  F R E E  S P A C E                                                                      *
@@ -264,6 +421,74 @@ float getPartitionFreeSpace (PARTITION_INFO *partInfo, unsigned long long *partT
 	return 0;
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  P A R T I T I O N  S P A C E                                                                             *
+ *  =====================================                                                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Called on the sampler thread to read the space used, each mount is only read when its copy is too old.
+ *  \param partSpace Array of PART_SPACE to fill in, it is kept by the job between calls.
+ *  \param network Read the network mounts rather than the local ones.
+ *  \result None.
+ */
+static void readPartitionSpace (PART_SPACE *partSpace, int network)
+{
+	PARTITION_INFO readParts[MAX_PARTITIONS];
+	int i, count;
+
+	pthread_mutex_lock (&partitionLock);
+	count = partitionCount;
+	memcpy (readParts, partitions, sizeof (PARTITION_INFO) * count);
+	pthread_mutex_unlock (&partitionLock);
+
+	for (i = 0; i < count; ++i)
+	{
+		if (!readParts[i].mounted || readParts[i].network != network)
+			continue;
+
+		if (partSpace[i].mountID != readParts[i].mountID || g_get_monotonic_time () >= partSpace[i].expires)
+		{
+			partSpace[i].percent = getPartitionFreeSpace (&readParts[i], &partSpace[i].total, &partSpace[i].used);
+			partSpace[i].mountID = readParts[i].mountID;
+			partSpace[i].expires = g_get_monotonic_time () + (network ? NET_SPACE_TTL : LOCAL_SPACE_TTL) * 1000;
+		}
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  L O C A L  S P A C E                                                                                     *
+ *  =============================                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Job function for the local mounts.
+ *  \param snapshot Array of PART_SPACE to fill in.
+ *  \result None.
+ */
+static void readLocalSpace (void *snapshot)
+{
+	readPartitionSpace ((PART_SPACE *)snapshot, 0);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  N E T W O R K  S P A C E                                                                                 *
+ *  =================================                                                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Job function for the network mounts.
+ *  \param snapshot Array of PART_SPACE to fill in.
+ *  \result None.
+ */
+static void readNetworkSpace (void *snapshot)
+{
+	readPartitionSpace ((PART_SPACE *)snapshot, 1);
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  S E T  A C T I V I T Y  S C A L E                                                                                 *
@@ -291,6 +516,278 @@ void setActivityScale (struct diskValues *values)
 	values -> oldScales[i] = scale;
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  D I S K  H A S H  K E Y                                                                                           *
+ *  =======================                                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Work out the hash bucket for a disk.
+ *  \param major Major device number.
+ *  \param minor Minor device number.
+ *  \result Bucket in the hash.
+ */
+static int diskHashKey (unsigned int major, unsigned int minor)
+{
+	return ((major * 31) + minor) & (diskHashSize - 1);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  G R O W  D I S K  H A S H                                                                                         *
+ *  =========================                                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Double the size of the hash and move the disks into the new buckets.
+ *  \result 1 if the hash was grown, 0 if there was no memory.
+ */
+static int growDiskHash (void)
+{
+	int i, oldSize = diskHashSize;
+	DISK_INFO **oldHash = diskHash, **newHash;
+
+	newHash = (DISK_INFO **)malloc (sizeof (DISK_INFO *) * (oldSize ? oldSize * 2 : 32));
+	if (newHash == NULL)
+		return 0;
+
+	diskHashSize = oldSize ? oldSize * 2 : 32;
+	memset (newHash, 0, sizeof (DISK_INFO *) * diskHashSize);
+	diskHash = newHash;
+
+	for (i = 0; i < oldSize; ++i)
+	{
+		DISK_INFO *thisDisk = oldHash[i], *nextDisk;
+		while (thisDisk != NULL)
+		{
+			int key = diskHashKey (thisDisk -> major, thisDisk -> minor);
+			nextDisk = thisDisk -> next;
+			thisDisk -> next = diskHash[key];
+			diskHash[key] = thisDisk;
+			thisDisk = nextDisk;
+		}
+	}
+	free (oldHash);
+	return 1;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  D I S K  B L O C K  S I Z E                                                                              *
+ *  ====================================                                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Look in sysfs to see if this is a partition and find the logical block size.
+ *  \param thisDisk Disk to fill in.
+ *  \result None.
+ */
+static void readDiskBlockSize (DISK_INFO *thisDisk)
+{
+	char fileName[81];
+	SAMPLE_FILE sizeFile = { fileName, -1 };
+
+	sprintf (fileName, "/sys/dev/block/%u:%u/partition", thisDisk -> major, thisDisk -> minor);
+	thisDisk -> isPartition = (access (fileName, F_OK) == 0);
+
+	sprintf (fileName, "/sys/dev/block/%u:%u/queue/logical_block_size", thisDisk -> major, thisDisk -> minor);
+	if (samplerRead (&sizeFile) != NULL)
+		thisDisk -> blockSize = atoi (sizeFile.buffer);
+	samplerClose (&sizeFile);
+
+	if (thisDisk -> blockSize <= 0)
+		thisDisk -> blockSize = 512;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  F I N D  D I S K                                                                                                  *
+ *  ================                                                                                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Find a disk, adding it and giving it a menu slot if it is a new whole disk.
+ *  \param major Major device number.
+ *  \param minor Minor device number.
+ *  \param name Name of the disk.
+ *  \result The disk, NULL if there was no memory.
+ */
+static DISK_INFO *findDisk (unsigned int major, unsigned int minor, char *name)
+{
+	DISK_INFO *thisDisk = NULL;
+	int key, slot;
+
+	if (diskHashSize)
+	{
+		thisDisk = diskHash[diskHashKey (major, minor)];
+		while (thisDisk != NULL)
+		{
+			if (thisDisk -> major == major && thisDisk -> minor == minor)
+				break;
+			thisDisk = thisDisk -> next;
+		}
+	}
+	if (thisDisk == NULL)
+	{
+		if (diskCount >= diskHashSize && !growDiskHash ())
+			return NULL;
+
+		if ((thisDisk = (DISK_INFO *)malloc (sizeof (DISK_INFO))) == NULL)
+			return NULL;
+
+		memset (thisDisk, 0, sizeof (DISK_INFO));
+		thisDisk -> major = major;
+		thisDisk -> minor = minor;
+		thisDisk -> seenID = -1;
+		strncpy (thisDisk -> name, name, 40);
+		readDiskBlockSize (thisDisk);
+		key = diskHashKey (major, minor);
+		thisDisk -> next = diskHash[key];
+		diskHash[key] = thisDisk;
+		++diskCount;
+
+		for (slot = 1; slot <= MAX_DISK_SLOTS && !thisDisk -> isPartition; ++slot)
+		{
+			if (diskSlots[slot] == NULL)
+			{
+				diskSlots[slot] = thisDisk;
+				thisDisk -> menuSlot = slot;
+				diskMenuDesc[slot].disable = 0;
+				diskMenuDesc[slot].menuName = thisDisk -> name;
+				gaugeMenuDesc[MENU_GAUGE_HARDDISK].disable = 0;
+				break;
+			}
+		}
+	}
+	return thisDisk;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S E T  D I S K  R A T E S                                                                                         *
+ *  =========================                                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Work out the rates from the change in the counters.
+ *  \param thisDisk Disk to update.
+ *  \param diff Change in the counters since the last read.
+ *  \param readTime Nanoseconds since the last read.
+ *  \result None.
+ */
+static void setDiskRates (DISK_INFO *thisDisk, struct diskCounters *diff, long long readTime)
+{
+	unsigned long long ioCount = diff -> reads + diff -> writes;
+	int i;
+
+	/*------------------------------------------------------------------------------------------------*
+     * Sectors in diskstats are always 512 bytes whatever the block size, rates are in KB/sec         *
+     *------------------------------------------------------------------------------------------------*/
+	thisDisk -> values[0].rate = ((double)diff -> readSectors * 512 / 1024) * 1000000000 / readTime;
+	thisDisk -> values[1].rate = ((double)diff -> writeSectors * 512 / 1024) * 1000000000 / readTime;
+	thisDisk -> values[2].rate = (double)ioCount * 1000000000 / readTime;
+	thisDisk -> values[3].rate = (double)diff -> queueTicks * 1000000 / readTime;
+	thisDisk -> values[4].rate = ioCount ? (double)(diff -> readTicks + diff -> writeTicks) / ioCount : 0;
+
+	for (i = 0; i < DISK_VALUES; ++i)
+		setActivityScale (&thisDisk -> values[i]);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  U P D A T E  D I S K                                                                                              *
+ *  ====================                                                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Save the new counters for a disk and work out the rates.
+ *  \param thisDisk Disk to update.
+ *  \param counters Counters just read.
+ *  \param allDiff Add the change to this for the total.
+ *  \param readTime Nanoseconds since the last read.
+ *  \result None.
+ */
+static void updateDisk (DISK_INFO *thisDisk, struct diskCounters *counters, struct diskCounters *allDiff, long long readTime)
+{
+	struct diskCounters *last = &thisDisk -> counters;
+	int firstSeen = (thisDisk -> seenID == -1);
+
+	thisDisk -> seenID = seenID;
+	if (firstSeen || counters -> reads < last -> reads || counters -> readSectors < last -> readSectors ||
+			counters -> readTicks < last -> readTicks || counters -> writes < last -> writes ||
+			counters -> writeSectors < last -> writeSectors || counters -> writeTicks < last -> writeTicks ||
+			counters -> queueTicks < last -> queueTicks)
+	{
+		/*--------------------------------------------------------------------------------------------*
+         * New disk or the counters wrapped, nothing to compare with yet                              *
+         *--------------------------------------------------------------------------------------------*/
+		memset (thisDisk -> values, 0, sizeof (thisDisk -> values));
+	}
+	else
+	{
+		struct diskCounters diff;
+
+		diff.reads = counters -> reads - last -> reads;
+		diff.readSectors = counters -> readSectors - last -> readSectors;
+		diff.readTicks = counters -> readTicks - last -> readTicks;
+		diff.writes = counters -> writes - last -> writes;
+		diff.writeSectors = counters -> writeSectors - last -> writeSectors;
+		diff.writeTicks = counters -> writeTicks - last -> writeTicks;
+		diff.queueTicks = counters -> queueTicks - last -> queueTicks;
+		setDiskRates (thisDisk, &diff, readTime);
+
+		allDiff -> reads += diff.reads;
+		allDiff -> readSectors += diff.readSectors;
+		allDiff -> readTicks += diff.readTicks;
+		allDiff -> writes += diff.writes;
+		allDiff -> writeSectors += diff.writeSectors;
+		allDiff -> writeTicks += diff.writeTicks;
+		allDiff -> queueTicks += diff.queueTicks;
+	}
+	*last = *counters;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  P R U N E  D I S K S                                                                                              *
+ *  ====================                                                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Remove the disks that have gone, the ones in the menu are kept but show nothing.
+ *  \result None.
+ */
+static void pruneDisks (void)
+{
+	int i;
+
+	for (i = 0; i < diskHashSize; ++i)
+	{
+		DISK_INFO **linkPtr = &diskHash[i];
+		while (*linkPtr != NULL)
+		{
+			DISK_INFO *thisDisk = *linkPtr;
+			if (thisDisk -> seenID == seenID)
+			{
+				linkPtr = &thisDisk -> next;
+			}
+			else if (thisDisk -> menuSlot)
+			{
+				memset (thisDisk -> values, 0, sizeof (thisDisk -> values));
+				thisDisk -> seenID = -1;
+				linkPtr = &thisDisk -> next;
+			}
+			else
+			{
+				*linkPtr = thisDisk -> next;
+				free (thisDisk);
+				--diskCount;
+			}
+		}
+	}
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  R E A D  A C T I V I T Y  V A L U E S                                                                             *
@@ -298,139 +795,84 @@ void setActivityScale (struct diskValues *values)
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
- *  \brief Read the number of sectors read.
+ *  \brief Read the activity of every disk from diskstats in one pass.
  *  \result None.
  */
 void readActivityValues()
 {
-	FILE *diskstats;
-	struct timeval tvTaken;
-	DISK_INFO *allDiskInfo = NULL, *thisDiskInfo = NULL;
-	char readBuff[256], readWord[256];
-	long thisTime = 0, readTime;
-	int disk = 1;
+	struct timespec now;
+	struct diskCounters allDiff;
+	long long thisTime, readTime;
+	char *ptr;
 
-	gettimeofday (&tvTaken, NULL);
-	thisTime = ((tvTaken.tv_sec % 100000) * 1000) + (tvTaken.tv_usec / 1000);
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	thisTime = ((long long)now.tv_sec * 1000000000) + now.tv_nsec;
 	readTime = thisTime - lastTime;
 	lastTime = thisTime;
-	if (!readTime) return;
+	if (readTime <= 0) return;
 
-	allDiskInfo = queueRead (diskActivity, 0);
-	allDiskInfo -> secRead.value = allDiskInfo -> secRead.rate = 0;
-	allDiskInfo -> secWrite.value = allDiskInfo -> secWrite.rate = 0;
+	if ((ptr = samplerRead (&diskStats)) == NULL)
+		return;
 
-	if ((diskstats = fopen (diskStats, "r")) != NULL)
+	memset (&allDiff, 0, sizeof (allDiff));
+	++seenID;
+
+	while (*ptr)
 	{
-		while (fgets (readBuff, 255, diskstats) && disk < (MAX_DISKS + 1))
+		char name[41];
+		int i = 0;
+		unsigned int major, minor;
+		struct diskCounters counters;
+
+		major = samplerReadNumber (&ptr);
+		minor = samplerReadNumber (&ptr);
+		while (*ptr == ' ')
+			++ptr;
+		while (ptr[i] > ' ' && i < 40)
 		{
-			int i = 0, j = 0, w = 0;
-			while (readBuff[i])
+			name[i] = ptr[i];
+			++i;
+		}
+		name[i] = 0;
+		ptr += i;
+
+		/*--------------------------------------------------------------------------------------------*
+         * Fields are: reads, merged, sectors, ms, writes, merged, sectors, ms, in flight, ms, weighted*
+         *--------------------------------------------------------------------------------------------*/
+		counters.reads = samplerReadNumber (&ptr);
+		samplerReadNumber (&ptr);
+		counters.readSectors = samplerReadNumber (&ptr);
+		counters.readTicks = samplerReadNumber (&ptr);
+		counters.writes = samplerReadNumber (&ptr);
+		samplerReadNumber (&ptr);
+		counters.writeSectors = samplerReadNumber (&ptr);
+		counters.writeTicks = samplerReadNumber (&ptr);
+		samplerReadNumber (&ptr);
+		samplerReadNumber (&ptr);
+		counters.queueTicks = samplerReadNumber (&ptr);
+
+		/* Ignore ram and loop disks */
+		if (name[0] && strncmp (name, "ram", 3) != 0 && strncmp (name, "loop", 4) != 0)
+		{
+			DISK_INFO *thisDisk = findDisk (major, minor, name);
+			if (thisDisk != NULL)
 			{
-				if (readBuff[0] == '#' && w == 0)
-					break;
-				if (readBuff[i] > ' ')
+				if (thisDisk -> isPartition)
 				{
-					if (j == 0)
-					{
-						if (++w == 11)
-							break;
-					}
-					readWord[j] = readBuff[i];
-					readWord[++j] = 0;
+					/* Only count the whole disk so nothing is counted twice */
+					thisDisk -> seenID = seenID;
+					thisDisk -> counters = counters;
 				}
-				else if (j)
+				else
 				{
-					if (w == 3)
-					{
-						int k = 0, f = 0;
-						DISK_INFO *tmpDiskInfo = NULL;
-
-						if (strncmp (readWord, "ram", 3) == 0 || strncmp (readWord, "loop", 4) == 0)
-						{
-							/* Ignore ram and loop diska */
-							break;
-						}
-						/* Find this disk, only look for sda ignore sda1 */
-						do
-						{
-							tmpDiskInfo = queueRead (diskActivity, ++k);
-							if (tmpDiskInfo != NULL)
-							{
-								if (strcmp (tmpDiskInfo -> name, readWord) == 0)
-								{
-									thisDiskInfo = tmpDiskInfo;
-									f = 1;
-								}
-								else if (strncmp (tmpDiskInfo -> name, readWord, strlen (tmpDiskInfo -> name)) == 0)
-								{
-									f = 2;
-								}
-							}
-						}
-						while (tmpDiskInfo != NULL && !f);
-
-						if (f == 2)
-						{
-							break;
-						}
-						else if (f == 0)
-						{
-							/* Create a new entry for this disk */
-							thisDiskInfo = (DISK_INFO *)malloc (sizeof (DISK_INFO));
-							memset (thisDiskInfo, 0, sizeof (DISK_INFO));
-							strncpy (thisDiskInfo -> name, readWord, 40);
-							thisDiskInfo -> name[40] = 0;
-							queuePut (diskActivity, thisDiskInfo);
-						}
-					}
-					if (w == 6)
-					{
-						unsigned long long diff;
-						unsigned long long value = atoll (readWord);
-						if (value < thisDiskInfo -> secRead.value)
-						{
-							thisDiskInfo -> secRead.value = value;
-							break;
-						}
-						diff = value - thisDiskInfo -> secRead.value;
-						thisDiskInfo -> secRead.rate = (diff * 1000) / readTime;
-						thisDiskInfo -> secRead.value = value;
-						allDiskInfo -> secRead.value += diff;
-					}
-					if (w == 10)
-					{
-						unsigned long long diff;
-						unsigned long long value = atoll (readWord);
-
-						if (value < thisDiskInfo -> secWrite.value)
-						{
-							thisDiskInfo -> secWrite.value = value;
-							break;
-						}
-						diff = value - thisDiskInfo -> secWrite.value;
-						thisDiskInfo -> secWrite.rate = (diff * 1000) / readTime;
-						thisDiskInfo -> secWrite.value = value;
-						allDiskInfo -> secWrite.value += diff;
-
-						setActivityScale (&thisDiskInfo -> secRead);
-						setActivityScale (&thisDiskInfo -> secWrite);
-
-						diskMenuDesc[disk].disable = 0;
-						diskMenuDesc[disk].menuName = thisDiskInfo -> name;
-						++disk;
-					}
-					j = 0;
+					updateDisk (thisDisk, &counters, &allDiff, readTime);
 				}
-				++i;
 			}
 		}
-		fclose (diskstats);
+		ptr = samplerNextLine (ptr);
 	}
-	allDiskInfo -> secRead.rate = (allDiskInfo -> secRead.value * 1000) / readTime;
-	allDiskInfo -> secWrite.rate = (allDiskInfo -> secWrite.value * 1000) / readTime;
-	setActivityScale (&allDiskInfo -> secRead);
-	setActivityScale (&allDiskInfo -> secWrite);
+	pruneDisks ();
+	setDiskRates (&allDisks, &allDiff, readTime);
 }
 
 /**********************************************************************************************************************
@@ -447,14 +889,20 @@ void readHarddiskInit (void)
 {
 	if (gaugeEnabled[FACE_TYPE_HARDDISK].enabled)
 	{
-		DISK_INFO *diskInfo = (DISK_INFO *)malloc (sizeof (DISK_INFO));
-		memset (diskInfo, 0, sizeof (DISK_INFO));
-		strcpy (diskInfo -> name, "All");
-		diskActivity = queueCreate();
-		queuePut (diskActivity, diskInfo);
-		partitionInfo = queueCreate();
+		int mountsHandle;
+
 		readPartitionNames();
 		readActivityValues();
+
+		/*--------------------------------------------------------------------------------------------*
+         * The kernel flags the mount table with POLLPRI when it changes, the main loop polls for it  *
+         *--------------------------------------------------------------------------------------------*/
+		if ((mountsHandle = open (mountInfo, O_RDONLY | O_CLOEXEC)) != -1)
+		{
+			GIOChannel *mountsChannel = g_io_channel_unix_new (mountsHandle);
+			g_io_add_watch (mountsChannel, G_IO_PRI | G_IO_ERR, mountsChanged, NULL);
+			g_io_channel_unref (mountsChannel);
+		}
 	}
 }
 
@@ -508,74 +956,114 @@ void readHarddiskValues (int face)
 	{
 		FACE_SETTINGS *faceSetting = faceSettings[face];
 
-		if (faceSetting -> faceFlags & FACE_REDRAW)
-		{
-			;
-		}
-		else if (sysUpdateID % (faceSetting -> faceSubType & 0x0300 ? 10 : 50) != 0)
+		if (faceSetting -> faceSubType & 0x0F00)
 		{
-			return;
-		}
-		if (faceSetting -> faceSubType & 0x0300)
-		{
-			DISK_INFO *thisDiskInfo = NULL;
+			DISK_INFO *thisDisk = NULL;
 			int scale, disk = faceSetting -> faceSubType & 0x00FF;
-			unsigned long value = 0;
-			char *nameT, *nameD;
+			int valueType = ((faceSetting -> faceSubType >> 8) & 0x0F) - 1;
+			static char *unitNames[] = { "KB/sec", "KB/sec", "/sec", "", "ms" };
+			char *nameT, *nameD, valueStr[41];
+			float value;
 
 			if (myUpdateID != sysUpdateID)
 			{
 				readActivityValues();
 				myUpdateID = sysUpdateID;
 			}
-			thisDiskInfo = queueRead (diskActivity, disk);
-			if (thisDiskInfo != NULL)
+			if (valueType >= DISK_VALUES)
+				valueType = 0;
+			if (disk > MAX_DISK_SLOTS || (thisDisk = diskSlots[disk]) == NULL)
+				thisDisk = &noDisk;
+
+			nameD = thisDisk -> name;
+			nameT = typeNames[valueType];
+			value = thisDisk -> values[valueType].rate;
+			if ((scale = thisDisk -> values[valueType].useScale) < 1)
+				scale = 1;
+			faceSetting -> firstValue = value / scale;
+
+			switch (valueType)
 			{
-				nameD = thisDiskInfo -> name;
-				if (faceSetting -> faceSubType & 0x0100)
-				{
-					nameT = typeNames[0];
-					scale = thisDiskInfo -> secRead.useScale;
-					faceSetting -> firstValue = value = thisDiskInfo -> secRead.rate;
-				}
-				else
-				{
-					nameT = typeNames[1];
-					scale = thisDiskInfo -> secWrite.useScale;
-					faceSetting -> firstValue = value = thisDiskInfo -> secWrite.rate;
-				}
-				faceSetting -> firstValue /= scale;
-				setFaceString (faceSetting, FACESTR_TOP, 0, _("%s\n(%s)"), gettext (nameT), nameD);
-				setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Sector %s</b>: %lu/sec (%s)"), gettext (nameT), value, nameD);
-				if (scale > 1)
-					setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.1f/sec\nx%d"), faceSetting -> firstValue, scale);
-				else
-					setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.1f/sec"), faceSetting -> firstValue);
-				setFaceString (faceSetting, FACESTR_WIN, 0, _("Sector %s - Gauge"), nameT);
+			case 0:
+			case 1:
+				strcat (sizeToString (value, valueStr), "B/sec");
+				break;
+			case 2:
+				sprintf (valueStr, "%0.1f/sec", value);
+				break;
+			case 3:
+				sprintf (valueStr, "%0.2f", value);
+				break;
+			default:
+				sprintf (valueStr, "%0.1f ms", value);
+				break;
+			}
+			setFaceString (faceSetting, FACESTR_TOP, 0, _("%s\n(%s)"), gettext (nameT), nameD);
+			if (valueType < 2 && thisDisk -> blockSize)
+				setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Disk %s</b>: %s (%s)\n<b>Block Size</b>: %d"), gettext (nameT),
+						valueStr, nameD, thisDisk -> blockSize);
+			else
+				setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Disk %s</b>: %s (%s)"), gettext (nameT), valueStr, nameD);
+			if (scale > 1)
+				setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.1f%s\nx%d"), faceSetting -> firstValue, unitNames[valueType], scale);
+			else
+				setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.1f%s"), faceSetting -> firstValue, unitNames[valueType]);
+			setFaceString (faceSetting, FACESTR_WIN, 0, _("Disk %s - Gauge"), gettext (nameT));
 
-				if (faceSetting -> updateNum != scale)
-				{
-					maxMinReset (&faceSetting -> savedMaxMin, 10, 2);
-					faceSetting -> faceFlags |= FACE_REDRAW;
-					faceSetting -> updateNum = scale;
-				}
+			if (faceSetting -> updateNum != scale)
+			{
+				maxMinReset (&faceSetting -> savedMaxMin, 10, 2);
+				faceSetting -> faceFlags |= FACE_REDRAW;
+				faceSetting -> updateNum = scale;
 			}
 		}
 		else
 		{
-			PARTITION_INFO *partInfo = queueRead (partitionInfo, faceSetting -> faceSubType);
-			if (partInfo != NULL)
+			PARTITION_INFO *partInfo = NULL;
+			PART_SPACE partSpace[MAX_PARTITIONS];
+			int state = SAMPLE_NONE, slot = faceSetting -> faceSubType;
+
+			if (slot < partitionCount)
+			{
+				partInfo = &partitions[slot];
+				if (partInfo -> mounted)
+					state = samplerGetSnapshot (spaceJobs[partInfo -> network], partSpace);
+			}
+			setFaceInterval (faceSetting, 2000);
+
+			if (partInfo == NULL)
+				;
+			else if (!partInfo -> mounted)
+			{
+				faceSetting -> firstValue = 0;
+				setFaceString (faceSetting, FACESTR_TOP, 0, _("Partition\n%s"), partInfo -> tidyName);
+				setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Not mounted</b>"));
+				setFaceString (faceSetting, FACESTR_WIN, 0, _("Partition Space: Not mounted - Gauge"));
+				setFaceString (faceSetting, FACESTR_BOT, 0, _("Unmounted"));
+			}
+			else if (state == SAMPLE_NONE || partSpace[slot].mountID != partInfo -> mountID)
+			{
+				/*------------------------------------------------------------------------------------*
+                 * Nothing from the sampler yet, try again soon                                       *
+                 *------------------------------------------------------------------------------------*/
+				setFaceInterval (faceSetting, 200);
+			}
+			else
 			{
 				char sizeStr[2][41];
-				unsigned long long partTotal, partSize;
+				PART_SPACE *thisSpace = &partSpace[slot];
 
-				faceSetting -> firstValue = getPartitionFreeSpace(partInfo, &partTotal, &partSize);
-				sizeToString (partTotal, sizeStr[0]);
-				sizeToString (partSize, sizeStr[1]);
+				faceSetting -> firstValue = thisSpace -> percent;
+				sizeToString (thisSpace -> total, sizeStr[0]);
+				sizeToString (thisSpace -> used, sizeStr[1]);
 
 				setFaceString (faceSetting, FACESTR_TOP, 0, _("Partition\n%s"), partInfo -> tidyName);
-				setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Used Space</b>: %0.1f%% (%s)\n<b>Total Size</b>: %s"),
-						faceSetting -> firstValue, sizeStr[1], sizeStr[0]);
+				if (state == SAMPLE_STALE)
+					setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Used Space</b>: %0.1f%% (%s)\n<b>Total Size</b>: %s\n"
+							"<b>Not responding</b>"), faceSetting -> firstValue, sizeStr[1], sizeStr[0]);
+				else
+					setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Used Space</b>: %0.1f%% (%s)\n<b>Total Size</b>: %s"),
+							faceSetting -> firstValue, sizeStr[1], sizeStr[0]);
 				setFaceString (faceSetting, FACESTR_WIN, 0, _("Partition Space: %0.1f%% Used - Gauge"), faceSetting -> firstValue);
 				setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.1f%%\n%s"), faceSetting -> firstValue, sizeStr[0]);
 			}
@@ -35,6 +35,7 @@ int readMemInfo (void);
 #define MAX_MEMINFO 6
 static int myUpdateID = 100;
 static unsigned long memValues[MAX_MEMINFO];
+static SAMPLE_FILE memInfoFile = { "/proc/meminfo", -1 };
 
 static char *infoName[MAX_MEMINFO] =
 {
@@ -93,14 +94,6 @@ void readMemoryValues (int face)
 		float value = 0, totalMem = 0;
 		unsigned long total;
 
-		if (faceSetting -> faceFlags & FACE_REDRAW)
-		{
-			;
-		}
-		else if (sysUpdateID % 15 != 0)
-		{
-			return;
-		}
 		if (myUpdateID != sysUpdateID)
 		{
 			readMemInfo ();
@@ -171,52 +164,22 @@ void readMemoryValues (int face)
  */
 int readMemInfo ()
 {
-	int i, j, k, n, found = 0;
-	char readBuff[1025], word[254];
-	FILE *inFile = fopen ("/proc/meminfo", "r");
+	int p, len, found = 0;
+	char *ptr = samplerRead (&memInfoFile);
 
-	while (inFile != NULL && found < MAX_MEMINFO)
+	while (ptr != NULL && *ptr && found < MAX_MEMINFO)
 	{
-		word[i = j = n = 0] = 0;
-		if (!fgets (readBuff, 1024, inFile))
-			break;
-
-		k = -1;
-		while (n < 2)
+		for (p = 0; p < MAX_MEMINFO; ++p)
 		{
-			if (readBuff[i] == ' ' || readBuff[i] == 0)
+			if ((len = samplerMatch (ptr, infoName[p])) != 0)
 			{
-				if (word[0])
-				{
-					if (n == 0)
-					{
-						int p;
-						for (p = 0; p < MAX_MEMINFO; ++p)
-							if (strcmp (infoName[p], word) == 0)
-								k = p;
-					}
-					else if (n == 1 && k != -1)
-					{
-						memValues[k] = atol (word);
-						++found;
-					}
-					word[j = 0] = 0;
-					n ++;
-				}
-				if (readBuff[i] == 0)
-					break;
+				ptr += len;
+				memValues[p] = samplerReadNumber (&ptr);
+				++found;
+				break;
 			}
-			else
-			{
-				word[j++] = readBuff[i];
-				word[j] = 0;
-			}
-			i ++;
 		}
-	}
-	if (inFile != NULL)
-	{
-		fclose (inFile);
+		ptr = samplerNextLine (ptr);
 	}
 	return found;
 }
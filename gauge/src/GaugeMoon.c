@@ -279,14 +279,6 @@ void readMoonPhaseValues (int face)
 	{
 		FACE_SETTINGS *faceSetting = faceSettings[face];
 
-		if (faceSetting -> faceFlags & FACE_REDRAW)
-		{
-			;
-		}
-		else if (sysUpdateID % 25 != 0)
-		{
-			return;
-		}
 		if (myUpdateID != sysUpdateID)
 		{
 			myUpdateID = sysUpdateID;
@@ -23,12 +23,18 @@
  */
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
 #include <dirent.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_link.h>
 
 #include "GaugeDisp.h"
 
 #define MAX_DEVICES		10
 #define MAX_SCALE_MEM	20
+#define NETLINK_BUFFER	32768
 
 extern FACE_SETTINGS *faceSettings[];
 extern GAUGE_ENABLED gaugeEnabled[];
@@ -48,17 +54,38 @@ typedef struct _devInfo
 	char name[41];
 	struct devValues dataRead;
 	struct devValues dataWrite;
+	int ifIndex;
+	int seenID;
+	int menuSlot;
+	struct _devInfo *next;
 }
 DEVICE_INFO;
 
 static int myUpdateID = 100;
-static long lastTime;
-static char *deviceStats = "/proc/net/dev";
+static int seenID;
+static long long lastTime;
+static SAMPLE_FILE deviceStats = { "/proc/net/dev", -1 };
 static char *typeNames[] = { "Rx", "Tx" };
-DEVICE_INFO deviceActivity[MAX_DEVICES + 1] =
-{
-	{ "All" }
-};
+
+/*----------------------------------------------------------------------------------------------------*
+ * Every device is kept in a hash keyed on the interface index (or name when read from /proc), only   *
+ * the first few get a slot in the menu.                                                              *
+ *----------------------------------------------------------------------------------------------------*/
+static DEVICE_INFO **deviceHash;
+static int deviceHashSize;
+static int deviceCount;
+static DEVICE_INFO allDevices = { "All" };
+static DEVICE_INFO noDevice = { "" };
+static DEVICE_INFO *deviceSlots[MAX_DEVICES + 1] = { &allDevices };
+
+/*----------------------------------------------------------------------------------------------------*
+ * The netlink socket is kept open, -2 means it could not be opened so use /proc.                     *
+ *----------------------------------------------------------------------------------------------------*/
+static int netlinkSocket = -1;
+static unsigned int netlinkSeq;
+static char *netlinkBuffer;
+static int netlinkBufferSize;
+static int usingProc;
 
 typedef struct _speedInfo
 {
@@ -114,109 +141,485 @@ void setDeviceScale (struct devValues *values)
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- *  R E A D  D E V I C E  V A L U E S                                                                                 *
- *  =================================                                                                                 *
+ *  D E V I C E  H A S H                                                                                              *
+ *  ====================                                                                                              *
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
- *  \brief Read the number of sectors read.
- *  \param lockScale Alter the scale after it is changed.
+ *  \brief Work out the hash bucket for a device.
+ *  \param ifIndex Interface index, 0 if not known.
+ *  \param name Name of the interface, used when there is no index.
+ *  \result Bucket in the hash.
+ */
+static int deviceHashKey (int ifIndex, char *name)
+{
+	unsigned int key = ifIndex;
+
+	if (!ifIndex)
+	{
+		while (*name)
+			key = (key * 31) + (unsigned char)*name++;
+	}
+	return key & (deviceHashSize - 1);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  G R O W  D E V I C E  H A S H                                                                                     *
+ *  =============================                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Double the size of the hash and move the devices into the new buckets.
+ *  \result 1 if the hash was grown, 0 if there was no memory.
+ */
+static int growDeviceHash (void)
+{
+	int i, oldSize = deviceHashSize;
+	DEVICE_INFO **oldHash = deviceHash, **newHash;
+
+	newHash = (DEVICE_INFO **)malloc (sizeof (DEVICE_INFO *) * (oldSize ? oldSize * 2 : 16));
+	if (newHash == NULL)
+		return 0;
+
+	deviceHashSize = oldSize ? oldSize * 2 : 16;
+	memset (newHash, 0, sizeof (DEVICE_INFO *) * deviceHashSize);
+	deviceHash = newHash;
+
+	for (i = 0; i < oldSize; ++i)
+	{
+		DEVICE_INFO *thisDevice = oldHash[i], *nextDevice;
+		while (thisDevice != NULL)
+		{
+			int key = deviceHashKey (thisDevice -> ifIndex, thisDevice -> name);
+			nextDevice = thisDevice -> next;
+			thisDevice -> next = deviceHash[key];
+			deviceHash[key] = thisDevice;
+			thisDevice = nextDevice;
+		}
+	}
+	free (oldHash);
+	return 1;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  F O R G E T  D E V I C E  I N D E X E S                                                                           *
+ *  =======================================                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Key every device on its name so /proc finds the ones netlink had already read.
  *  \result None.
  */
-void readDeviceValues()
+static void forgetDeviceIndexes (void)
 {
-	FILE *devstats;
-	struct timeval tvTaken;
-	char readBuff[1025], readWord[256];
-	long thisTime = 0, readTime;
-	int device = 1;
-
-	gettimeofday (&tvTaken, NULL);
-	thisTime = ((tvTaken.tv_sec % 100000) * 1000) + (tvTaken.tv_usec / 1000);
-	readTime = thisTime - lastTime;
-	lastTime = thisTime;
-	if (!readTime) return;
+	DEVICE_INFO *rehashList = NULL;
+	int i;
 
-	deviceActivity[0].dataRead.value = deviceActivity[0].dataRead.rate = 0;
-	deviceActivity[0].dataWrite.value = deviceActivity[0].dataWrite.rate = 0;
+	for (i = 0; i < deviceHashSize; ++i)
+	{
+		while (deviceHash[i] != NULL)
+		{
+			DEVICE_INFO *thisDevice = deviceHash[i];
+			deviceHash[i] = thisDevice -> next;
+			thisDevice -> ifIndex = 0;
+			thisDevice -> next = rehashList;
+			rehashList = thisDevice;
+		}
+	}
+	while (rehashList != NULL)
+	{
+		DEVICE_INFO *thisDevice = rehashList;
+		int key = deviceHashKey (0, thisDevice -> name);
+		rehashList = thisDevice -> next;
+		thisDevice -> next = deviceHash[key];
+		deviceHash[key] = thisDevice;
+	}
+}
 
-	if ((devstats = fopen (deviceStats, "r")) != NULL)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  F I N D  D E V I C E                                                                                              *
+ *  ====================                                                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Find a device, adding it and giving it a menu slot if it is new.
+ *  \param ifIndex Interface index, 0 if not known.
+ *  \param name Name of the interface.
+ *  \result The device, NULL if there was no memory.
+ */
+static DEVICE_INFO *findDevice (int ifIndex, char *name)
+{
+	DEVICE_INFO *thisDevice = NULL;
+	int key, slot;
+
+	if (deviceHashSize)
 	{
-		while (fgets (readBuff, 1024, devstats) && device < (MAX_DEVICES + 1))
+		thisDevice = deviceHash[deviceHashKey (ifIndex, name)];
+		while (thisDevice != NULL)
 		{
-			int i = 0, j = 0, w = 0;
+			if (thisDevice -> ifIndex == ifIndex && (ifIndex || strcmp (thisDevice -> name, name) == 0))
+				break;
+			thisDevice = thisDevice -> next;
+		}
+	}
+	if (thisDevice == NULL)
+	{
+		if (deviceCount >= deviceHashSize && !growDeviceHash ())
+			return NULL;
 
-			if (strncmp (readBuff, "Inter", 5) == 0 || strncmp (readBuff, " face", 5) == 0)
+		if ((thisDevice = (DEVICE_INFO *)malloc (sizeof (DEVICE_INFO))) == NULL)
+			return NULL;
+
+		memset (thisDevice, 0, sizeof (DEVICE_INFO));
+		thisDevice -> ifIndex = ifIndex;
+		thisDevice -> seenID = -1;
+		strncpy (thisDevice -> name, name, 40);
+		key = deviceHashKey (ifIndex, thisDevice -> name);
+		thisDevice -> next = deviceHash[key];
+		deviceHash[key] = thisDevice;
+		++deviceCount;
+
+		for (slot = 1; slot <= MAX_DEVICES; ++slot)
+		{
+			if (deviceSlots[slot] == NULL)
+			{
+				deviceSlots[slot] = thisDevice;
+				thisDevice -> menuSlot = slot;
+				networkDevDesc[slot].disable = 0;
+				networkDevDesc[slot].menuName = thisDevice -> name;
+				gaugeMenuDesc[MENU_GAUGE_NETWORK].disable = 0;
+				break;
+			}
+		}
+	}
+	else if (ifIndex && strcmp (thisDevice -> name, name) != 0)
+	{
+		/*--------------------------------------------------------------------------------------------*
+         * Interface was renamed, the menu points at the name so it follows                           *
+         *--------------------------------------------------------------------------------------------*/
+		strncpy (thisDevice -> name, name, 40);
+	}
+	return thisDevice;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  U P D A T E  D E V I C E                                                                                          *
+ *  ========================                                                                                          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Save the new counters for a device and work out the rates.
+ *  \param thisDevice Device to update.
+ *  \param readBytes Total bytes received.
+ *  \param writeBytes Total bytes sent.
+ *  \param readTime Nanoseconds since the last read.
+ *  \result None.
+ */
+static void updateDevice (DEVICE_INFO *thisDevice, unsigned long long readBytes, unsigned long long writeBytes, long long readTime)
+{
+	int firstSeen = (thisDevice -> seenID == -1);
+
+	thisDevice -> seenID = seenID;
+	if (firstSeen || readBytes < thisDevice -> dataRead.value || writeBytes < thisDevice -> dataWrite.value)
+	{
+		/*--------------------------------------------------------------------------------------------*
+         * New device or the counters were reset, nothing to compare with yet                         *
+         *--------------------------------------------------------------------------------------------*/
+		thisDevice -> dataRead.rate = thisDevice -> dataWrite.rate = 0;
+	}
+	else
+	{
+		unsigned long long readDiff = readBytes - thisDevice -> dataRead.value;
+		unsigned long long writeDiff = writeBytes - thisDevice -> dataWrite.value;
+
+		thisDevice -> dataRead.rate = (double)readDiff * 1000000000 / readTime;
+		thisDevice -> dataWrite.rate = (double)writeDiff * 1000000000 / readTime;
+		allDevices.dataRead.value += readDiff;
+		allDevices.dataWrite.value += writeDiff;
+	}
+	thisDevice -> dataRead.value = readBytes;
+	thisDevice -> dataWrite.value = writeBytes;
+
+	setDeviceScale (&thisDevice -> dataRead);
+	setDeviceScale (&thisDevice -> dataWrite);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  P R U N E  D E V I C E S                                                                                          *
+ *  ========================                                                                                          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Remove the devices that have gone, the ones in the menu are kept but show nothing.
+ *  \result None.
+ */
+static void pruneDevices (void)
+{
+	int i;
+
+	for (i = 0; i < deviceHashSize; ++i)
+	{
+		DEVICE_INFO **linkPtr = &deviceHash[i];
+		while (*linkPtr != NULL)
+		{
+			DEVICE_INFO *thisDevice = *linkPtr;
+			if (thisDevice -> seenID == seenID)
+			{
+				linkPtr = &thisDevice -> next;
+			}
+			else if (thisDevice -> menuSlot)
+			{
+				thisDevice -> dataRead.rate = thisDevice -> dataWrite.rate = 0;
+				linkPtr = &thisDevice -> next;
+			}
+			else
+			{
+				*linkPtr = thisDevice -> next;
+				free (thisDevice);
+				--deviceCount;
+			}
+		}
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  N E T L I N K  V A L U E S                                                                               *
+ *  ===================================                                                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the 64 bit counters for every interface with one RTM_GETLINK dump.
+ *  \param readTime Nanoseconds since the last read.
+ *  \result 1 if the values were read, 0 if netlink cannot be used, -1 to skip this sample.
+ */
+static int readNetlinkValues (long long readTime)
+{
+	struct
+	{
+		struct nlmsghdr header;
+		struct ifinfomsg info;
+	}
+	request;
+	int done = 0, retry = 0;
+
+	if (netlinkSocket == -1)
+	{
+		netlinkSocket = socket (AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+		if (netlinkSocket < 0)
+		{
+			netlinkSocket = -2;
+			return 0;
+		}
+		if (netlinkBuffer == NULL)
+		{
+			netlinkBufferSize = NETLINK_BUFFER;
+			netlinkBuffer = (char *)malloc (netlinkBufferSize);
+		}
+	}
+	if (netlinkSocket < 0 || netlinkBuffer == NULL)
+		return 0;
+
+	memset (&request, 0, sizeof (request));
+	request.header.nlmsg_len = NLMSG_LENGTH (sizeof (struct ifinfomsg));
+	request.header.nlmsg_type = RTM_GETLINK;
+	request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+	request.header.nlmsg_seq = ++netlinkSeq;
+	request.info.ifi_family = AF_UNSPEC;
+
+	if (send (netlinkSocket, &request, request.header.nlmsg_len, 0) < 0)
+	{
+		close (netlinkSocket);
+		netlinkSocket = -2;
+		return 0;
+	}
+
+	while (!done)
+	{
+		struct nlmsghdr *header;
+		int readLen = recv (netlinkSocket, netlinkBuffer, netlinkBufferSize, MSG_TRUNC);
+
+		if (readLen < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			close (netlinkSocket);
+			netlinkSocket = -2;
+			return 0;
+		}
+		if (readLen > netlinkBufferSize)
+		{
+			/*----------------------------------------------------------------------------------------*
+             * Part of the dump was lost, make the buffer bigger and drain the rest, skip this sample *
+             *----------------------------------------------------------------------------------------*/
+			char *newBuffer = (char *)realloc (netlinkBuffer, readLen);
+			if (newBuffer != NULL)
+			{
+				netlinkBuffer = newBuffer;
+				netlinkBufferSize = readLen;
+			}
+			retry = 1;
+			continue;
+		}
+		for (header = (struct nlmsghdr *)netlinkBuffer; NLMSG_OK (header, readLen); header = NLMSG_NEXT (header, readLen))
+		{
+			if (header -> nlmsg_seq != netlinkSeq)
 				continue;
 
-			while (readBuff[i])
+			if (header -> nlmsg_type == NLMSG_ERROR && netlinkSeq == 1)
 			{
-				if (readBuff[0] == '#' && w == 0)
-					break;
-				if (readBuff[i] > ' ' && readBuff[i] != ':')
-				{
-					if (j == 0)
-					{
-						if (++w == 11)
-							break;
-					}
-					readWord[j] = readBuff[i];
-					readWord[++j] = 0;
-				}
-				else if (j)
+				/*------------------------------------------------------------------------------------*
+                 * Not allowed to dump the links, use /proc from now on                               *
+                 *------------------------------------------------------------------------------------*/
+				close (netlinkSocket);
+				netlinkSocket = -2;
+				return 0;
+			}
+			if (header -> nlmsg_type == NLMSG_DONE || header -> nlmsg_type == NLMSG_ERROR)
+			{
+				if (header -> nlmsg_type == NLMSG_ERROR)
+					retry = 1;
+				done = 1;
+				break;
+			}
+			if (header -> nlmsg_type == RTM_NEWLINK && !retry)
+			{
+				struct ifinfomsg *info = (struct ifinfomsg *)NLMSG_DATA (header);
+				struct rtattr *attr = IFLA_RTA (info);
+				int attrLen = IFLA_PAYLOAD (header), haveStats = 0;
+				unsigned long long readBytes = 0, writeBytes = 0;
+				char *name = NULL;
+
+				for (; RTA_OK (attr, attrLen); attr = RTA_NEXT (attr, attrLen))
 				{
-					if (w == 1)
+					if (attr -> rta_type == IFLA_IFNAME)
 					{
-						readWord[40] = 0;
-						strcpy (deviceActivity[device].name, readWord);
+						name = (char *)RTA_DATA (attr);
 					}
-					if (w == 2)
+					else if (attr -> rta_type == IFLA_STATS64 && RTA_PAYLOAD (attr) >= sizeof (struct rtnl_link_stats64))
 					{
-						unsigned long long diff;
-						unsigned long long value = atoll (readWord);
-						if (value < deviceActivity[device].dataRead.value)
-						{
-							deviceActivity[device].dataRead.value = value;
-							break;
-						}
-						diff = value - deviceActivity[device].dataRead.value;
-						deviceActivity[device].dataRead.rate = (diff * 1000) / readTime;
-						deviceActivity[device].dataRead.value = value;
-						deviceActivity[0].dataRead.value += diff;
+						struct rtnl_link_stats64 stats;
+						memcpy (&stats, RTA_DATA (attr), sizeof (stats));
+						readBytes = stats.rx_bytes;
+						writeBytes = stats.tx_bytes;
+						haveStats = 2;
 					}
-					if (w == 10)
+					else if (attr -> rta_type == IFLA_STATS && haveStats < 2 && RTA_PAYLOAD (attr) >= sizeof (struct rtnl_link_stats))
 					{
-						unsigned long long diff;
-						unsigned long long value = atoll (readWord);
-						if (value < deviceActivity[device].dataWrite.value)
-						{
-							deviceActivity[device].dataWrite.value = value;
-							break;
-						}
-						diff = value - deviceActivity[device].dataWrite.value;
-						deviceActivity[device].dataWrite.rate = (diff * 1000) / readTime;
-						deviceActivity[device].dataWrite.value = value;
-						deviceActivity[0].dataWrite.value += diff;
-
-						setDeviceScale (&deviceActivity[device].dataRead);
-						setDeviceScale (&deviceActivity[device].dataWrite);
-
-						networkDevDesc[device].disable = 0;
-						networkDevDesc[device].menuName = deviceActivity[device].name;
-						gaugeMenuDesc[MENU_GAUGE_NETWORK].disable = 0;
-						++device;
+						struct rtnl_link_stats stats;
+						memcpy (&stats, RTA_DATA (attr), sizeof (stats));
+						readBytes = stats.rx_bytes;
+						writeBytes = stats.tx_bytes;
+						haveStats = 1;
 					}
-					j = 0;
 				}
-				++i;
+				if (name != NULL && haveStats)
+				{
+					DEVICE_INFO *thisDevice = findDevice (info -> ifi_index, name);
+					if (thisDevice != NULL)
+						updateDevice (thisDevice, readBytes, writeBytes, readTime);
+				}
 			}
 		}
-		fclose (devstats);
 	}
-	deviceActivity[0].dataRead.rate = (deviceActivity[0].dataRead.value * 1000) / readTime;
-	deviceActivity[0].dataWrite.rate = (deviceActivity[0].dataWrite.value * 1000) / readTime;
-	setDeviceScale (&deviceActivity[0].dataRead);
-	setDeviceScale (&deviceActivity[0].dataWrite);
+	return retry ? -1 : 1;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  P R O C  V A L U E S                                                                                     *
+ *  =============================                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the counters from /proc/net/dev when netlink cannot be used.
+ *  \param readTime Nanoseconds since the last read.
+ *  \result None.
+ */
+static void readProcValues (long long readTime)
+{
+	char *ptr = samplerRead (&deviceStats);
+
+	while (ptr != NULL && *ptr)
+	{
+		char name[41];
+		int i = 0, j;
+		unsigned long long readBytes, writeBytes = 0;
+
+		while (*ptr == ' ')
+			++ptr;
+		while (ptr[i] && ptr[i] != ':' && ptr[i] != '\n' && i < 40)
+		{
+			name[i] = ptr[i];
+			++i;
+		}
+		name[i] = 0;
+		if (ptr[i] == ':')
+		{
+			ptr += i + 1;
+			readBytes = samplerReadNumber (&ptr);
+			for (j = 0; j < 8; ++j)
+				writeBytes = samplerReadNumber (&ptr);
+
+			DEVICE_INFO *thisDevice = findDevice (0, name);
+			if (thisDevice != NULL && thisDevice -> seenID != seenID)
+				updateDevice (thisDevice, readBytes, writeBytes, readTime);
+		}
+		ptr = samplerNextLine (ptr);
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  D E V I C E  V A L U E S                                                                                 *
+ *  =================================                                                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the bytes sent and received on every interface.
+ *  \result None.
+ */
+void readDeviceValues()
+{
+	struct timespec now;
+	long long thisTime, readTime;
+	int netlinkState;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	thisTime = ((long long)now.tv_sec * 1000000000) + now.tv_nsec;
+	readTime = thisTime - lastTime;
+	lastTime = thisTime;
+	if (readTime <= 0) return;
+
+	allDevices.dataRead.value = allDevices.dataRead.rate = 0;
+	allDevices.dataWrite.value = allDevices.dataWrite.rate = 0;
+	++seenID;
+
+	if ((netlinkState = readNetlinkValues (readTime)) == 0)
+	{
+		/*--------------------------------------------------------------------------------------------*
+         * Netlink may have stopped part way through the dump, the devices it did read are found by   *
+         * name and skipped so they are not counted twice.                                            *
+         *--------------------------------------------------------------------------------------------*/
+		if (!usingProc)
+		{
+			forgetDeviceIndexes ();
+			usingProc = 1;
+		}
+		readProcValues (readTime);
+	}
+	if (netlinkState >= 0)
+		pruneDevices ();
+
+	allDevices.dataRead.rate = (double)allDevices.dataRead.value * 1000000000 / readTime;
+	allDevices.dataWrite.rate = (double)allDevices.dataWrite.value * 1000000000 / readTime;
+	setDeviceScale (&allDevices.dataRead);
+	setDeviceScale (&allDevices.dataWrite);
 }
 
 /**********************************************************************************************************************
@@ -257,34 +660,30 @@ void readNetworkValues (int face)
 		int faceType = (faceSetting -> faceSubType >> 8) & 1;
 		unsigned long value = 0;
 		char *nameT, *nameD;
+		DEVICE_INFO *thisDevice;
 
-		if (faceSetting -> faceFlags & FACE_REDRAW)
-		{
-			;
-		}
-		else if (sysUpdateID % 10 != 0)
-		{
-			return;
-		}
 		if (myUpdateID != sysUpdateID)
 		{
 			readDeviceValues();
 			myUpdateID = sysUpdateID;
 		}
 
-		nameD = deviceActivity[device].name;
+		if (device > MAX_DEVICES || (thisDevice = deviceSlots[device]) == NULL)
+			thisDevice = &noDevice;
+
+		nameD = thisDevice -> name;
 		if (faceType)
 		{
 			nameT = typeNames[0];
-			scale = deviceActivity[device].dataRead.useScale;
-			value = faceSetting -> firstValue = deviceActivity[device].dataRead.rate;
+			scale = thisDevice -> dataRead.useScale;
+			value = faceSetting -> firstValue = thisDevice -> dataRead.rate;
 			
 		}
 		else
 		{
 			nameT = typeNames[1];
-			scale = deviceActivity[device].dataWrite.useScale;
-			value = faceSetting -> firstValue = deviceActivity[device].dataWrite.rate;
+			scale = thisDevice -> dataWrite.useScale;
+			value = faceSetting -> firstValue = thisDevice -> dataWrite.rate;
 		}
 		
 		faceSetting -> firstValue *= 8;
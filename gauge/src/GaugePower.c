@@ -63,6 +63,22 @@ typedef struct _powerReading
 }
 PowerReading;
 
+/*----------------------------------------------------------------------------------------------------*
+ * The reader thread fills in a sample and passes it to the main loop, which passes it back when done *
+ *----------------------------------------------------------------------------------------------------*/
+typedef struct _powerSample
+{
+	double value[POWER_MAX_READING];
+	char showValue[POWER_MAX_READING][21];
+	time_t readTime;
+}
+POWER_SAMPLE;
+
+static POWER_SAMPLE powerSamples[2];
+static POWER_SAMPLE *spareSample = NULL;		/* Only used by the reader thread */
+static void *sampleQueue = NULL;
+static void *freeQueue = NULL;
+
 PowerReading myPowerReading[POWER_MAX_READING] =
 {
 	{ "now", "Current", "%0.0fW", "%0.1fKW", 0, "NA" },				//  0
@@ -97,6 +113,11 @@ PowerReading myPowerReading[POWER_MAX_READING] =
  */
 void readPowerMeterInit (void)
 {
+	if ((sampleQueue = queueCreateSPSC (2)) != NULL && (freeQueue = queueCreateSPSC (2)) != NULL)
+	{
+		queuePut (freeQueue, &powerSamples[0]);
+		queuePut (freeQueue, &powerSamples[1]);
+	}
 	if (gaugeEnabled[FACE_TYPE_POWER].enabled)
 	{
 		int clientSock = ConnectClientSocket (powerServer, powerPort, 3, USE_ANY, NULL);
@@ -116,12 +137,13 @@ void readPowerMeterInit (void)
  **********************************************************************************************************************/
 /**
  *  \brief Process each of the fields in the XML.
+ *  \param sample Save the readings here.
  *  \param readLevel 0 current, 1 today, 2 tomorrow.
  *  \param name Name of the field.
  *  \param value Value of the field.
  *  \result None.
  */
-static void processPowerKey (int readLevel, const char *name, char *value)
+static void processPowerKey (POWER_SAMPLE *sample, int readLevel, const char *name, char *value)
 {
 	int i;
 	for (i = 0; i < POWER_MAX_READING; ++i)
@@ -130,18 +152,18 @@ static void processPowerKey (int readLevel, const char *name, char *value)
 		{
 			if (strcmp (name, myPowerReading[i].name) == 0)
 			{
-				myPowerReading[i].value = atof (value);
-				if (myPowerReading[i].value == -1)
+				sample -> value[i] = atof (value);
+				if (sample -> value[i] == -1)
 				{
-					strcpy (myPowerReading[i].showValue, "NA");
+					strcpy (sample -> showValue[i], "NA");
 				}
-				else if (myPowerReading[i].value >= 1000)
+				else if (sample -> value[i] >= 1000)
 				{
-					sprintf (myPowerReading[i].showValue, myPowerReading[i].formatHigh, myPowerReading[i].value / 1000);
+					sprintf (sample -> showValue[i], myPowerReading[i].formatHigh, sample -> value[i] / 1000);
 				}
 				else
 				{
-					sprintf (myPowerReading[i].showValue, myPowerReading[i].formatLow, myPowerReading[i].value);
+					sprintf (sample -> showValue[i], myPowerReading[i].formatLow, sample -> value[i]);
 				}
 			}
 		}
@@ -156,12 +178,13 @@ static void processPowerKey (int readLevel, const char *name, char *value)
  **********************************************************************************************************************/
 /**
  *  \brief Process each of the elements in the file.
+ *  \param sample Save the readings here.
  *  \param doc Document to read.
  *  \param aNode Current node.
  *  \param readLevel 0 current, 1 today, 2 tomorrow.
  *  \result None.
  */
-static void processElementNames (xmlDoc *doc, xmlNode * aNode, int readLevel)
+static void processElementNames (POWER_SAMPLE *sample, xmlDoc *doc, xmlNode * aNode, int readLevel)
 {
 	xmlChar *key;
 	xmlNode *curNode = NULL;
@@ -173,16 +196,16 @@ static void processElementNames (xmlDoc *doc, xmlNode * aNode, int readLevel)
 			if ((!xmlStrcmp (curNode -> name, (const xmlChar *)"power")))
 			{
 				++readLevel;
-				lastRead = time (NULL);
+				sample -> readTime = time (NULL);
 			}
 			else
 			{
 				key = xmlNodeListGetString (doc, curNode -> xmlChildrenNode, 1);
-				processPowerKey (readLevel, (const char *)curNode -> name, (char *)key);
+				processPowerKey (sample, readLevel, (const char *)curNode -> name, (char *)key);
 				xmlFree (key);
 			}
 		}
-		processElementNames (doc, curNode->children, readLevel);
+		processElementNames (sample, doc, curNode->children, readLevel);
 	}
 }
 
@@ -194,11 +217,12 @@ static void processElementNames (xmlDoc *doc, xmlNode * aNode, int readLevel)
  **********************************************************************************************************************/
 /**
  *  \brief Process the down loaded buffer.
+ *  \param sample Save the readings here.
  *  \param buffer Buffer to process.
  *  \param size Size of the buffer.
  *  \result None.
  */
-static void processBuffer (char *buffer, size_t size)
+static void processBuffer (POWER_SAMPLE *sample, char *buffer, size_t size)
 {
 	xmlDoc *doc = NULL;
 	xmlNode *rootElement = NULL;
@@ -212,7 +236,7 @@ static void processBuffer (char *buffer, size_t size)
 		if (doc != NULL)
 		{
 			rootElement = xmlDocGetRootElement (doc);
-			processElementNames (doc, rootElement, 0);
+			processElementNames (sample, doc, rootElement, 0);
 			xmlFreeDoc (doc);
 		}
 		else
@@ -239,8 +263,20 @@ void *readPowerMeterInfo (void *notUsed)
 {
 	char buffer[512] = "";
 	int bytesRead = 0;
-	
+	POWER_SAMPLE *sample;
+
 	powerState = POWER_STATE_PENDING;
+
+	/*------------------------------------------------------------------------------------------------*
+     * Both samples are waiting to be shown, so nothing to fill in. A sample kept from a failed read  *
+     * is used again, only the main loop puts samples back on the free queue.                         *
+     *------------------------------------------------------------------------------------------------*/
+	if ((sample = spareSample) == NULL && (freeQueue == NULL || (sample = queueGet (freeQueue)) == NULL))
+	{
+		powerState = POWER_STATE_UPDATED;
+		return NULL;
+	}
+
 	int clientSock = ConnectClientSocket (powerServer, powerPort, 3, USE_ANY, NULL);
 	if (SocketValid (clientSock))
 	{
@@ -252,12 +288,22 @@ void *readPowerMeterInfo (void *notUsed)
 	}
 	if (bytesRead)
 	{
-		processBuffer (buffer, bytesRead);
+		int i;
+		for (i = 0; i < POWER_MAX_READING; ++i)
+		{
+			sample -> value[i] = -1;
+			strcpy (sample -> showValue[i], "NA");
+		}
+		sample -> readTime = 0;
+		processBuffer (sample, buffer, bytesRead);
+		spareSample = NULL;
+		queuePut (sampleQueue, sample);
 		powerStart = 0;
 		powerState = POWER_STATE_UPDATED;
 	}
 	else
 	{
+		spareSample = sample;
 		powerState = POWER_STATE_ERROR;
 	}
 	return NULL;
@@ -302,6 +348,25 @@ void readPowerMeterValues (int face)
 	{
 		FACE_SETTINGS *faceSetting = faceSettings[face];
 		char readTimeStr[81] = "Never";
+		POWER_SAMPLE *sample;
+
+		/*--------------------------------------------------------------------------------------------*
+         * Pick up any samples from the reader thread                                                 *
+         *--------------------------------------------------------------------------------------------*/
+		while (sampleQueue != NULL && (sample = queueGet (sampleQueue)) != NULL)
+		{
+			int i;
+			for (i = 0; i < POWER_MAX_READING; ++i)
+			{
+				myPowerReading[i].value = sample -> value[i];
+				strcpy (myPowerReading[i].showValue, sample -> showValue[i]);
+			}
+			if (sample -> readTime)
+			{
+				lastRead = sample -> readTime;
+			}
+			queuePut (freeQueue, sample);
+		}
 
 		if (faceSetting -> faceFlags & FACE_REDRAW)
 		{
@@ -315,7 +380,7 @@ void readPowerMeterValues (int face)
 		else if (!faceSetting -> nextUpdate)
 		{
 			startUpdatePowerInfo ();
-			faceSetting -> nextUpdate = (powerStart ? 5 : 60);
+			faceSetting -> nextUpdate = (powerStart ? 1 : 12);
 		}
 
 		if (lastRead != 0)
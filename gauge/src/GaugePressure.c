@@ -0,0 +1,276 @@
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  G A U G E  P R E S S U R E . C                                                                                    *
+ *  ==============================                                                                                    *
+ *                                                                                                                    *
+ *  Copyright (c) 2023 Chris Knight                                                                                   *
+ *                                                                                                                    *
+ *  File GaugePressure.c part of Gauge is free software: you can redistribute it and/or modify it under the terms of  *
+ *  the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or  *
+ *  (at your option) any later version.                                                                               *
+ *                                                                                                                    *
+ *  Gauge is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied       *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more     *
+ *  details.                                                                                                          *
+ *                                                                                                                    *
+ *  You should have received a copy of the GNU General Public License along with this program. If not, see:           *
+ *  <http://www.gnu.org/licenses/>                                                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \file
+ *  \brief Handle a gauge that shows pressure stall information.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+
+#include "GaugeDisp.h"
+
+#define PSI_COUNT		3
+#define STALL_SHOW_TIME	10000000
+
+extern FACE_SETTINGS *faceSettings[];
+extern GAUGE_ENABLED gaugeEnabled[];
+extern MENU_DESC gaugeMenuDesc[];
+extern MENU_DESC pressureMenuDesc[];
+
+typedef struct _psiLine
+{
+	float avg[3];
+	unsigned long long total;
+}
+PSI_LINE;
+
+typedef struct _psiInfo
+{
+	char *name;
+	SAMPLE_FILE psiFile;
+	int triggerHandle;
+	int hasFull;
+	gint64 lastStall;
+	PSI_LINE some;
+	PSI_LINE full;
+}
+PSI_INFO;
+
+static PSI_INFO psiInfo[PSI_COUNT] =
+{
+	{	"CPU",		{ "/proc/pressure/cpu", -1 },		-1	},
+	{	"Memory",	{ "/proc/pressure/memory", -1 },	-1	},
+	{	"I/O",		{ "/proc/pressure/io", -1 },		-1	}
+};
+
+/*----------------------------------------------------------------------------------------------------*
+ * Tell us when tasks stall for 150ms in any 2 seconds, 2 seconds is the shortest window allowed      *
+ * when not running as root.                                                                          *
+ *----------------------------------------------------------------------------------------------------*/
+static char *psiTrigger = "some 150000 2000000";
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  P R E S S U R E  L I N E                                                                                 *
+ *  =================================                                                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the averages and total from one line of a pressure file.
+ *  \param ptr Start of the values, after some or full.
+ *  \param psiLine Where to save the values.
+ *  \result None.
+ */
+static void readPressureLine (char *ptr, PSI_LINE *psiLine)
+{
+	int i;
+
+	for (i = 0; i < 4; ++i)
+	{
+		while (*ptr && *ptr != '=' && *ptr != '\n')
+			++ptr;
+		if (*ptr != '=')
+			break;
+		++ptr;
+		if (i < 3)
+			psiLine -> avg[i] = samplerReadFloat (&ptr);
+		else
+			psiLine -> total = samplerReadNumber (&ptr);
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  P R E S S U R E  F I L E                                                                                 *
+ *  =================================                                                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the some and full lines from a pressure file.
+ *  \param info Which pressure to read.
+ *  \result 1 if the file was read, 0 if it could not be.
+ */
+static int readPressureFile (PSI_INFO *info)
+{
+	char *ptr = samplerRead (&info -> psiFile);
+	int len;
+
+	if (ptr == NULL)
+		return 0;
+
+	while (*ptr)
+	{
+		if ((len = samplerMatch (ptr, "some")) != 0)
+		{
+			readPressureLine (&ptr[len], &info -> some);
+		}
+		else if ((len = samplerMatch (ptr, "full")) != 0)
+		{
+			readPressureLine (&ptr[len], &info -> full);
+			info -> hasFull = 1;
+		}
+		ptr = samplerNextLine (ptr);
+	}
+	return 1;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  P R E S S U R E  T R I G G E R E D                                                                                *
+ *  ==================================                                                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Called from the main loop when the kernel says a trigger has fired.
+ *  \param source Channel on the trigger.
+ *  \param condition What woke us up.
+ *  \param data Pressure the trigger is for.
+ *  \result TRUE to keep watching, FALSE if the trigger has gone.
+ */
+static gboolean pressureTriggered (GIOChannel *source, GIOCondition condition, gpointer data)
+{
+	PSI_INFO *info = (PSI_INFO *)data;
+
+	if (condition & G_IO_ERR)
+	{
+		close (info -> triggerHandle);
+		info -> triggerHandle = -1;
+		return FALSE;
+	}
+	info -> lastStall = g_get_monotonic_time ();
+	wakeFaceType (FACE_TYPE_PRESSURE);
+	return TRUE;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  A D D  P R E S S U R E  T R I G G E R                                                                             *
+ *  =====================================                                                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Write a trigger to a pressure file and have the main loop poll it for POLLPRI.
+ *  \param info Which pressure to watch.
+ *  \result None.
+ */
+static void addPressureTrigger (PSI_INFO *info)
+{
+	GIOChannel *triggerChannel;
+
+	if ((info -> triggerHandle = open (info -> psiFile.fileName, O_RDWR | O_NONBLOCK)) == -1)
+		return;
+
+	/*------------------------------------------------------------------------------------------------*
+     * Older kernels and some containers do not allow triggers, then the face is only sampled         *
+     *------------------------------------------------------------------------------------------------*/
+	if (write (info -> triggerHandle, psiTrigger, strlen (psiTrigger) + 1) < 0)
+	{
+		close (info -> triggerHandle);
+		info -> triggerHandle = -1;
+		return;
+	}
+	triggerChannel = g_io_channel_unix_new (info -> triggerHandle);
+	g_io_add_watch (triggerChannel, G_IO_PRI | G_IO_ERR, pressureTriggered, info);
+	g_io_channel_unref (triggerChannel);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  P R E S S U R E  I N I T                                                                                 *
+ *  =================================                                                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Initialise the gauge, only pressures the kernel reports are put in the menu.
+ *  \result None.
+ */
+void readPressureInit (void)
+{
+	int i;
+
+	if (gaugeEnabled[FACE_TYPE_PRESSURE].enabled)
+	{
+		for (i = 0; i < PSI_COUNT; ++i)
+		{
+			if (readPressureFile (&psiInfo[i]))
+			{
+				addPressureTrigger (&psiInfo[i]);
+				pressureMenuDesc[i].disable = 0;
+				gaugeMenuDesc[MENU_GAUGE_PRESSURE].disable = 0;
+			}
+		}
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  P R E S S U R E  V A L U E S                                                                             *
+ *  =====================================                                                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the stall averages for the face, the ten second average is the first hand and the minute the second.
+ *  \param face Which face is this for.
+ *  \result None.
+ */
+void readPressureValues (int face)
+{
+	if (gaugeEnabled[FACE_TYPE_PRESSURE].enabled)
+	{
+		FACE_SETTINGS *faceSetting = faceSettings[face];
+		PSI_INFO *info = &psiInfo[faceSetting -> faceSubType < PSI_COUNT ? faceSetting -> faceSubType : 0];
+		int stalled;
+
+		if (!readPressureFile (info))
+		{
+			faceSetting -> firstValue = faceSetting -> secondValue = 0;
+			setFaceString (faceSetting, FACESTR_TOP, 0, _("Pressure\n%s"), gettext (info -> name));
+			setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>%s Pressure</b>: Not available"), gettext (info -> name));
+			setFaceString (faceSetting, FACESTR_BOT, 0, _("N/A"));
+			return;
+		}
+
+		/*--------------------------------------------------------------------------------------------*
+         * The kernel only updates the averages every 2 seconds, sample faster while stalling         *
+         *--------------------------------------------------------------------------------------------*/
+		stalled = (info -> lastStall && g_get_monotonic_time () - info -> lastStall < STALL_SHOW_TIME);
+		if (stalled)
+			setFaceInterval (faceSetting, 500);
+
+		faceSetting -> firstValue = info -> some.avg[0];
+		faceSetting -> secondValue = info -> some.avg[1];
+
+		setFaceString (faceSetting, FACESTR_TOP, 0, _("Pressure\n%s"), gettext (info -> name));
+		if (info -> hasFull)
+			setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>%s Pressure</b>\n<b>Some</b>: %0.2f%%, %0.2f%%, %0.2f%%\n"
+					"<b>Full</b>: %0.2f%%, %0.2f%%, %0.2f%%"), gettext (info -> name), info -> some.avg[0], info -> some.avg[1],
+					info -> some.avg[2], info -> full.avg[0], info -> full.avg[1], info -> full.avg[2]);
+		else
+			setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>%s Pressure</b>\n<b>Some</b>: %0.2f%%, %0.2f%%, %0.2f%%"),
+					gettext (info -> name), info -> some.avg[0], info -> some.avg[1], info -> some.avg[2]);
+		setFaceString (faceSetting, FACESTR_WIN, 0, _("%s Pressure: %0.1f%% - Gauge"), gettext (info -> name),
+				faceSetting -> firstValue);
+		if (stalled)
+			setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.1f%%\nStalled"), faceSetting -> firstValue);
+		else
+			setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.1f%%"), faceSetting -> firstValue);
+	}
+}
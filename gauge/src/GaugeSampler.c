@@ -0,0 +1,422 @@
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  G A U G E  S A M P L E R . C                                                                                      *
+ *  ============================                                                                                      *
+ *                                                                                                                    *
+ *  Copyright (c) 2023 Chris Knight                                                                                   *
+ *                                                                                                                    *
+ *  File GaugeSampler.c part of Gauge is free software: you can redistribute it and/or modify it under the terms of   *
+ *  the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or  *
+ *  (at your option) any later version.                                                                               *
+ *                                                                                                                    *
+ *  Gauge is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied       *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more     *
+ *  details.                                                                                                          *
+ *                                                                                                                    *
+ *  You should have received a copy of the GNU General Public License along with this program. If not, see:           *
+ *  <http://www.gnu.org/licenses/>                                                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \file
+ *  \brief Keep the /proc and /sys files open and re-read them from the start for each sample, run the
+ *  sources that can block on their own threads.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sched.h>
+#include "GaugeDisp.h"
+
+#define SAMPLE_BUFF_STEP	4096
+
+extern int sysUpdateID;
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E R  R E A D                                                                                            *
+ *  ======================                                                                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the whole file into the sample buffer, only once for each update.
+ *  \param sampleFile File to read, it is opened the first time.
+ *  \result Pointer to the contents, zero terminated, or NULL if it could not be read.
+ */
+char *samplerRead (SAMPLE_FILE *sampleFile)
+{
+	int readSize;
+
+	if (sampleFile -> readID == sysUpdateID && sampleFile -> readSize > 0)
+		return sampleFile -> buffer;
+
+	if (sampleFile -> fileHandle == -1)
+	{
+		if ((sampleFile -> fileHandle = open (sampleFile -> fileName, O_RDONLY | O_CLOEXEC)) == -1)
+			return NULL;
+	}
+	while (1)
+	{
+		if (sampleFile -> bufferSize == 0)
+		{
+			if ((sampleFile -> buffer = malloc (SAMPLE_BUFF_STEP)) == NULL)
+				return NULL;
+			sampleFile -> bufferSize = SAMPLE_BUFF_STEP;
+		}
+		if ((readSize = pread (sampleFile -> fileHandle, sampleFile -> buffer, sampleFile -> bufferSize - 1, 0)) < 0)
+		{
+			/*----------------------------------------------------------------------------------------*
+             * The file has gone (battery removed, device unplugged), open it again next time         *
+             *----------------------------------------------------------------------------------------*/
+			samplerClose (sampleFile);
+			return NULL;
+		}
+		if (readSize < sampleFile -> bufferSize - 1)
+			break;
+		else
+		{
+			char *newBuffer = realloc (sampleFile -> buffer, sampleFile -> bufferSize + SAMPLE_BUFF_STEP);
+			if (newBuffer == NULL)
+				break;
+			sampleFile -> buffer = newBuffer;
+			sampleFile -> bufferSize += SAMPLE_BUFF_STEP;
+		}
+	}
+	sampleFile -> buffer[readSize] = 0;
+	sampleFile -> readSize = readSize;
+	sampleFile -> readID = sysUpdateID;
+	return sampleFile -> buffer;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E R  E X P I R E                                                                                        *
+ *  ==========================                                                                                        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Make the next samplerRead go to the file, for readers that are not called from the tick.
+ *  \param sampleFile File to expire.
+ *  \result None.
+ */
+void samplerExpire (SAMPLE_FILE *sampleFile)
+{
+	sampleFile -> readSize = 0;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E R  C L O S E                                                                                          *
+ *  ========================                                                                                          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Close the file and free the buffer, it will be opened again by the next read.
+ *  \param sampleFile File to close.
+ *  \result None.
+ */
+void samplerClose (SAMPLE_FILE *sampleFile)
+{
+	if (sampleFile -> fileHandle != -1)
+	{
+		close (sampleFile -> fileHandle);
+		sampleFile -> fileHandle = -1;
+	}
+	if (sampleFile -> buffer != NULL)
+	{
+		free (sampleFile -> buffer);
+		sampleFile -> buffer = NULL;
+	}
+	sampleFile -> bufferSize = sampleFile -> readSize = 0;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E R  N E X T  L I N E                                                                                   *
+ *  ===============================                                                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Move on to the start of the next line.
+ *  \param ptr Somewhere in the current line.
+ *  \result Start of the next line, points at the terminator if there are no more.
+ */
+char *samplerNextLine (char *ptr)
+{
+	while (*ptr && *ptr != '\n')
+		++ptr;
+	if (*ptr)
+		++ptr;
+	return ptr;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E R  G E T  L I N E                                                                                     *
+ *  =============================                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Copy the next line to a buffer, works like fgets but from the sample buffer.
+ *  \param ptr Current position, moved on to the next line.
+ *  \param line Where to copy the line, the new line is kept.
+ *  \param maxLen Size of the line buffer.
+ *  \result The line, or NULL at the end of the buffer.
+ */
+char *samplerGetLine (char **ptr, char *line, int maxLen)
+{
+	int i = 0;
+	char *inPtr = *ptr;
+
+	if (inPtr == NULL || *inPtr == 0)
+		return NULL;
+
+	while (*inPtr && i < maxLen - 1)
+	{
+		if ((line[i++] = *inPtr++) == '\n')
+			break;
+	}
+	line[i] = 0;
+	*ptr = inPtr;
+	return line;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E R  M A T C H                                                                                          *
+ *  ========================                                                                                          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Check if the text starts with a string.
+ *  \param ptr Text to check.
+ *  \param prefix String to look for.
+ *  \result Length of the prefix if it matches, otherwise 0.
+ */
+int samplerMatch (char *ptr, char *prefix)
+{
+	int i = 0;
+
+	while (prefix[i])
+	{
+		if (ptr[i] != prefix[i])
+			return 0;
+		++i;
+	}
+	return i;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E R  R E A D  N U M B E R                                                                               *
+ *  ===================================                                                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read a whole number, skipping any spaces in front of it.
+ *  \param ptr Current position, moved on past the number.
+ *  \result The number read, 0 if there is no number.
+ */
+long long samplerReadNumber (char **ptr)
+{
+	long long value = 0;
+	int negative = 0;
+	char *inPtr = *ptr;
+
+	while (*inPtr == ' ' || *inPtr == '\t')
+		++inPtr;
+	if (*inPtr == '-')
+	{
+		negative = 1;
+		++inPtr;
+	}
+	while (*inPtr >= '0' && *inPtr <= '9')
+		value = (value * 10) + (*inPtr++ - '0');
+
+	*ptr = inPtr;
+	return negative ? -value : value;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E R  R E A D  F L O A T                                                                                 *
+ *  =================================                                                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read a number with a decimal point, skipping any spaces in front of it.
+ *  \param ptr Current position, moved on past the number.
+ *  \result The number read, 0 if there is no number.
+ */
+float samplerReadFloat (char **ptr)
+{
+	float value, scale = 1;
+	char *inPtr;
+	int negative = 0;
+
+	while (**ptr == ' ' || **ptr == '\t')
+		++(*ptr);
+	if (**ptr == '-')
+	{
+		negative = 1;
+		++(*ptr);
+	}
+	value = samplerReadNumber (ptr);
+	inPtr = *ptr;
+	if (*inPtr == '.')
+	{
+		++inPtr;
+		while (*inPtr >= '0' && *inPtr <= '9')
+		{
+			scale /= 10;
+			value += (*inPtr++ - '0') * scale;
+		}
+	}
+	*ptr = inPtr;
+	return negative ? -value : value;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E R  T I M E                                                                                            *
+ *  ======================                                                                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the monotonic clock.
+ *  \result Time in milliseconds.
+ */
+static long long samplerTime (void)
+{
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	return ((long long)now.tv_sec * 1000) + (now.tv_nsec / 1000000);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E R  J O B  T H R E A D                                                                                 *
+ *  =================================                                                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Run one job for ever, each sample is published through the sequence count.
+ *  \param arg The job to run.
+ *  \result None.
+ */
+static void *samplerJobThread (void *arg)
+{
+	SAMPLE_JOB *job = (SAMPLE_JOB *)arg;
+	struct timespec sleepTime;
+
+	sleepTime.tv_sec = job -> interval / 1000;
+	sleepTime.tv_nsec = (job -> interval % 1000) * 1000000;
+
+	while (1)
+	{
+		__atomic_store_n (&job -> startedAt, samplerTime (), __ATOMIC_RELAXED);
+		job -> sampleFunc (job -> working);
+		__atomic_store_n (&job -> startedAt, 0, __ATOMIC_RELAXED);
+
+		/*--------------------------------------------------------------------------------------------*
+         * Odd sequence while the copy is written, the reader tries again if it changes under it      *
+         *--------------------------------------------------------------------------------------------*/
+		__atomic_store_n (&job -> sequence, job -> sequence + 1, __ATOMIC_RELAXED);
+		__atomic_thread_fence (__ATOMIC_RELEASE);
+		memcpy (job -> snapshot, job -> working, job -> snapshotSize);
+		__atomic_store_n (&job -> sequence, job -> sequence + 1, __ATOMIC_RELEASE);
+		__atomic_store_n (&job -> doneAt, samplerTime (), __ATOMIC_RELAXED);
+
+		nanosleep (&sleepTime, NULL);
+	}
+	return NULL;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E R  S T A R T  J O B                                                                                   *
+ *  ===============================                                                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Start a thread that fills in a snapshot every interval, away from the GTK main loop.
+ *  \param sampleFunc Function to fill in the snapshot, called on the sampler thread.
+ *  \param snapshotSize Size of the snapshot.
+ *  \param interval Milliseconds between samples.
+ *  \param timeout Milliseconds before the snapshot is thought to be stuck.
+ *  \result Handle of the job, NULL if it could not be started.
+ */
+SAMPLE_JOB *samplerStartJob (void (*sampleFunc) (void *snapshot), int snapshotSize, int interval, int timeout)
+{
+	SAMPLE_JOB *job = (SAMPLE_JOB *)malloc (sizeof (SAMPLE_JOB));
+
+	if (job == NULL)
+		return NULL;
+
+	memset (job, 0, sizeof (SAMPLE_JOB));
+	job -> sampleFunc = sampleFunc;
+	job -> snapshotSize = snapshotSize;
+	job -> interval = interval;
+	job -> timeout = timeout;
+	job -> snapshot = malloc (snapshotSize);
+	job -> working = malloc (snapshotSize);
+
+	if (job -> snapshot != NULL && job -> working != NULL)
+	{
+		memset (job -> working, 0, snapshotSize);
+		if (pthread_create (&job -> threadHandle, NULL, samplerJobThread, job) == 0)
+		{
+			pthread_detach (job -> threadHandle);
+			return job;
+		}
+	}
+	free (job -> snapshot);
+	free (job -> working);
+	free (job);
+	return NULL;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E R  G E T  S N A P S H O T                                                                             *
+ *  =====================================                                                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Copy out the last snapshot published by a job, never waits for the job.
+ *  \param job Job to read from.
+ *  \param snapshot Where to copy the snapshot.
+ *  \result SAMPLE_FRESH, SAMPLE_STALE if the job is stuck or SAMPLE_NONE if there is nothing yet.
+ */
+int samplerGetSnapshot (SAMPLE_JOB *job, void *snapshot)
+{
+	unsigned int before, after;
+	long long now = samplerTime (), startedAt, doneAt;
+
+	if (job == NULL)
+		return SAMPLE_NONE;
+
+	do
+	{
+		while ((before = __atomic_load_n (&job -> sequence, __ATOMIC_ACQUIRE)) & 1)
+			sched_yield ();
+		memcpy (snapshot, job -> snapshot, job -> snapshotSize);
+		__atomic_thread_fence (__ATOMIC_ACQUIRE);
+		after = __atomic_load_n (&job -> sequence, __ATOMIC_RELAXED);
+	}
+	while (before != after);
+
+	if (before == 0)
+		return SAMPLE_NONE;
+
+	startedAt = __atomic_load_n (&job -> startedAt, __ATOMIC_RELAXED);
+	doneAt = __atomic_load_n (&job -> doneAt, __ATOMIC_RELAXED);
+	if ((startedAt && now - startedAt > job -> timeout) || now - doneAt > job -> timeout + job -> interval)
+		return SAMPLE_STALE;
+
+	return SAMPLE_FRESH;
+}
@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
 
 #include "GaugeDisp.h"
 #include "config.h"
@@ -42,17 +43,32 @@ extern MENU_DESC sInputMenuDesc[];
 extern MENU_DESC sensorMenuDesc[];
 extern int sysUpdateID;
 
-static char *sysThermalFile = "/sys/class/thermal/thermal_zone0/temp";
+static SAMPLE_FILE thermalFile = { "/sys/class/thermal/thermal_zone0/temp", -1 };
 static int initSensorsOK = 0;
 
 #if SENSORS_API_VERSION >= 1024
 
-int faceTypes[3] =
+#define MAX_SENSORS	15
+
+/*----------------------------------------------------------------------------------------------------*
+ * Each sensor in the menu is found once at start, the value is read from the hwmon file when it      *
+ * gives the same answer as libsensors, so there is no compute line in the config for it.             *
+ *----------------------------------------------------------------------------------------------------*/
+typedef struct _sensorHandle
 {
-	SENSORS_SUBFEATURE_TEMP_INPUT,
-	SENSORS_SUBFEATURE_FAN_INPUT,
-	SENSORS_SUBFEATURE_IN_INPUT
-};
+	const sensors_chip_name *chipset;
+	int subNumber;
+	int useFile;
+	int readID;
+	int readOK;
+	double divider;
+	double value;
+	char sensorName[41];
+	SAMPLE_FILE inputFile;
+}
+SENSOR_HANDLE;
+
+static SENSOR_HANDLE sensorHandles[3][MAX_SENSORS];
 
 /**********************************************************************************************************************
  *                                                                                                                    *
@@ -102,6 +118,111 @@ char *appendExtra (char *inStr, char *outStr, int maxLen)
 	return outStr;
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  A D D  S E N S O R  H A N D L E                                                                                   *
+ *  ===============================                                                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Save a handle for a sensor found in the menu, and open its hwmon file if it can be used.
+ *  \param handle Handle to fill in.
+ *  \param chipset Chip the sensor is on.
+ *  \param feature Feature of the sensor, used for the label.
+ *  \param subfeature The input subfeature to read.
+ *  \param namePrefix Start of the name, e.g. "Temp %d".
+ *  \param number Sensor number shown in the name.
+ *  \result None.
+ */
+static void addSensorHandle (SENSOR_HANDLE *handle, const sensors_chip_name *chipset, const sensors_feature *feature,
+		const sensors_subfeature *subfeature, char *namePrefix, int number)
+{
+	char *label, *ptr, fileName[PATH_MAX];
+	double value;
+
+	handle -> chipset = chipset;
+	handle -> subNumber = subfeature -> number;
+	handle -> readID = -1;
+	handle -> inputFile.fileHandle = -1;
+	handle -> divider = (subfeature -> type == SENSORS_SUBFEATURE_FAN_INPUT ? 1 : 1000);
+
+	sprintf (handle -> sensorName, gettext (namePrefix), number + 1);
+	if ((label = sensors_get_label (chipset, feature)) != NULL)
+	{
+		appendExtra (label, &handle -> sensorName[strlen (handle -> sensorName)], 12);
+		free (label);
+	}
+
+	if (chipset -> path != NULL)
+	{
+		snprintf (fileName, PATH_MAX, "%s/%s", chipset -> path, subfeature -> name);
+		if ((handle -> inputFile.fileName = strdup (fileName)) != NULL)
+		{
+			int tries;
+
+			/*----------------------------------------------------------------------------------------*
+             * With no compute line the file matches libsensors to within a couple of raw units. Read *
+             * both again once if they differ, the sensor may have moved between the two reads.       *
+             *----------------------------------------------------------------------------------------*/
+			for (tries = 0; tries < 2 && !handle -> useFile; ++tries)
+			{
+				double fileValue, diff;
+
+				samplerExpire (&handle -> inputFile);
+				if (sensors_get_value (chipset, subfeature -> number, &value) != 0 ||
+						(ptr = samplerRead (&handle -> inputFile)) == NULL)
+				{
+					break;
+				}
+				fileValue = (double)samplerReadNumber (&ptr) / handle -> divider;
+				diff = fileValue > value ? fileValue - value : value - fileValue;
+				if (diff <= 2.0 / handle -> divider)
+				{
+					handle -> useFile = 1;
+				}
+			}
+		}
+		if (!handle -> useFile)
+		{
+			samplerClose (&handle -> inputFile);
+		}
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  S E N S O R  H A N D L E                                                                                 *
+ *  =================================                                                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the value of a sensor, only once per tick however many faces show it.
+ *  \param handle Sensor to read.
+ *  \result 1 if the value was read.
+ */
+static int readSensorHandle (SENSOR_HANDLE *handle)
+{
+	if (handle -> readID != sysUpdateID)
+	{
+		handle -> readID = sysUpdateID;
+		handle -> readOK = 0;
+		if (handle -> useFile)
+		{
+			char *ptr = samplerRead (&handle -> inputFile);
+			if (ptr != NULL && (*ptr == '-' || (*ptr >= '0' && *ptr <= '9')))
+			{
+				handle -> value = (double)samplerReadNumber (&ptr) / handle -> divider;
+				handle -> readOK = 1;
+			}
+		}
+		else if (handle -> chipset != NULL)
+		{
+			handle -> readOK = (sensors_get_value (handle -> chipset, handle -> subNumber, &handle -> value) == 0);
+		}
+	}
+	return handle -> readOK;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  F I N D  S E N S O R S                                                                                            *
@@ -136,6 +257,7 @@ int findSensors ()
 				{
 					if (gaugeEnabled[FACE_TYPE_SENSOR_TEMP].enabled)
 					{
+						addSensorHandle (&sensorHandles[0][tempCount], chipset, feature, subfeature, __("Temp %d"), tempCount);
 						sTempMenuDesc[tempCount].disable = 0;
 						++tempCount;
 					}
@@ -144,6 +266,7 @@ int findSensors ()
 				{
 					if (gaugeEnabled[FACE_TYPE_SENSOR_FAN].enabled)
 					{
+						addSensorHandle (&sensorHandles[1][fanCount], chipset, feature, subfeature, __("Fan %d"), fanCount);
 						sFanMenuDesc[fanCount].disable = 0;
 						++fanCount;
 					}
@@ -152,6 +275,7 @@ int findSensors ()
 				{
 					if (gaugeEnabled[FACE_TYPE_SENSOR_INPUT].enabled)
 					{
+						addSensorHandle (&sensorHandles[2][inputCount], chipset, feature, subfeature, __("Input %d"), inputCount);
 						sInputMenuDesc[inputCount].disable = 0;
 						++inputCount;
 					}
@@ -203,9 +327,9 @@ void readSensorInit (void)
 			gaugeEnabled[FACE_TYPE_SENSOR_FAN].enabled ||
 			gaugeEnabled[FACE_TYPE_SENSOR_INPUT].enabled)
 	{
+#if SENSORS_API_VERSION >= 1024
 		FILE *inputFile = NULL;
 
-#if SENSORS_API_VERSION >= 1024
 		if ((inputFile = fopen ("/etc/sensors3.conf", "r")) != NULL)
 		{
 			if (sensors_init(inputFile) == 0)
@@ -218,13 +342,12 @@ void readSensorInit (void)
 			fclose (inputFile);
 		}
 #endif
-		if ((inputFile = fopen (sysThermalFile, "r")) != NULL)
+		if (samplerRead (&thermalFile) != NULL)
 		{
 			sTempMenuDesc[15].disable = 0;
 			sensorMenuDesc[MENU_SENSOR_TEMP].disable = 0;
 			gaugeMenuDesc[MENU_GAUGE_SENSOR].disable = 0;
 			initSensorsOK |= 2;
-			fclose (inputFile);
 		}
 	}
 }
@@ -249,145 +372,88 @@ void readSensorValues (int face)
 		FACE_SETTINGS *faceSetting = faceSettings[face];
 
 #if SENSORS_API_VERSION >= 1024
-		int nr = 0, count = 0;
 		int type = faceSetting -> showFaceType;
 		int number = faceSetting -> faceSubType;
-		const sensors_chip_name *chipset;
-		const sensors_feature *feature;
-		const sensors_subfeature *subfeature;
-#endif
 
-		if (faceSetting -> faceFlags & FACE_REDRAW)
+		if ((initSensorsOK & 1) && number < MAX_SENSORS)
 		{
-			;
-		}
-		else if (sysUpdateID % 10 != 0)
-		{
-			return;
-		}
+			SENSOR_HANDLE *handle = &sensorHandles[type == FACE_TYPE_SENSOR_INPUT ? 2 : type - FACE_TYPE_SENSOR_TEMP][number];
 
-#if SENSORS_API_VERSION >= 1024
-		if (initSensorsOK & 1)
-		{
-			chipset = sensors_get_detected_chips (NULL, &nr);
-			while (chipset)
+			if (readSensorHandle (handle))
 			{
-				int nr1 = 0;
+				double value = handle -> value;
+				char *prefix = handle -> chipset -> prefix;
 
-				feature = sensors_get_features (chipset, &nr1);
-				while (feature)
+				switch (type)
 				{
-					int nr2 = 0;
-
-					subfeature = sensors_get_all_subfeatures (chipset, feature, &nr2);
-					while (subfeature)
+				case FACE_TYPE_SENSOR_TEMP:
+					if (gaugeEnabled[FACE_TYPE_SENSOR_TEMP].enabled)
 					{
-						if (subfeature -> type == faceTypes[type - FACE_TYPE_SENSOR_TEMP])
+						setFaceString (faceSetting, FACESTR_TOP, 0, handle -> sensorName);
+						setFaceString (faceSetting, FACESTR_WIN, 0, _("Sensor Temp %d - Gauge"), number + 1);
+						setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Sensor Temp %d</b>: %0.0f\302\260C\n"
+									"<b>Chipset Name</b>: %s"), number + 1, value, prefix);
+						setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.0f\302\260C"), value);
+						faceSetting -> firstValue = value;
+						while (faceSetting -> firstValue > faceSetting -> faceScaleMax)
 						{
-							if (count++ == number)
-							{
-								double value;
-
-								if (sensors_get_value (chipset, nr2 - 1, &value) == 0)
-								{
-									char *label, sensorName[41];
-
-									switch (type)
-									{
-									case FACE_TYPE_SENSOR_TEMP:
-										if (gaugeEnabled[FACE_TYPE_SENSOR_TEMP].enabled)
-										{
-											sprintf (sensorName, _("Temp %d"), number + 1);
-											if ((label = sensors_get_label (chipset, feature)) != NULL)
-											{
-												appendExtra (label, &sensorName[strlen (sensorName)], 12);
-												free (label);
-											}	
-											setFaceString (faceSetting, FACESTR_TOP, 0, sensorName);
-											setFaceString (faceSetting, FACESTR_WIN, 0, _("Sensor Temp %d - Gauge"), number + 1);
-											setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Sensor Temp %d</b>: %0.0f\302\260C\n"
-														"<b>Chipset Name</b>: %s"), number + 1, value, chipset -> prefix);
-											setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.0f\302\260C"), value);
-											faceSetting -> firstValue = value;
-											while (faceSetting -> firstValue > faceSetting -> faceScaleMax)
-											{
-												faceSetting -> faceScaleMax += 25;
-												maxMinReset (&faceSetting -> savedMaxMin, 10, 2);
-											}
-										}
-										break;
+							faceSetting -> faceScaleMax += 25;
+							maxMinReset (&faceSetting -> savedMaxMin, 10, 2);
+						}
+					}
+					break;
 
-									case FACE_TYPE_SENSOR_FAN:
-										if (gaugeEnabled[FACE_TYPE_SENSOR_FAN].enabled)
-										{
-											sprintf (sensorName, _("Fan %d"), number + 1);
-											if ((label = sensors_get_label (chipset, feature)) != NULL)
-											{
-												appendExtra (label, &sensorName[strlen (sensorName)], 12);
-												free (label);
-											}
-											setFaceString (faceSetting, FACESTR_TOP, 0, _("Fan %d"), number + 1);
-											setFaceString (faceSetting, FACESTR_WIN, 0, _("Sensor Fan %d - Gauge"), number + 1);
-											setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Sensor Fan %d</b>: %0.0f rpm\n"
-														"<b>Chipset Name</b>: %s"), number + 1, value, chipset -> prefix);
-											setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.0f\n(rpm)"), value);
-											faceSetting -> firstValue = value / 100;
-											while (faceSetting -> firstValue > faceSetting -> faceScaleMax)
-											{
-												faceSetting -> faceScaleMax += 25;
-												maxMinReset (&faceSetting -> savedMaxMin, 10, 2);
-											}
-										}
-										break;
+				case FACE_TYPE_SENSOR_FAN:
+					if (gaugeEnabled[FACE_TYPE_SENSOR_FAN].enabled)
+					{
+						setFaceString (faceSetting, FACESTR_TOP, 0, _("Fan %d"), number + 1);
+						setFaceString (faceSetting, FACESTR_WIN, 0, _("Sensor Fan %d - Gauge"), number + 1);
+						setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Sensor Fan %d</b>: %0.0f rpm\n"
+									"<b>Chipset Name</b>: %s"), number + 1, value, prefix);
+						setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.0f\n(rpm)"), value);
+						faceSetting -> firstValue = value / 100;
+						while (faceSetting -> firstValue > faceSetting -> faceScaleMax)
+						{
+							faceSetting -> faceScaleMax += 25;
+							maxMinReset (&faceSetting -> savedMaxMin, 10, 2);
+						}
+					}
+					break;
 
-									case FACE_TYPE_SENSOR_INPUT:
-										if (gaugeEnabled[FACE_TYPE_SENSOR_INPUT].enabled)
-										{
-											sprintf (sensorName, _("Input %d"), number + 1);
-											if ((label = sensors_get_label (chipset, feature)) != NULL)
-											{
-												appendExtra (label, &sensorName[strlen (sensorName)], 12);
-												free (label);
-											}
-											setFaceString (faceSetting, FACESTR_TOP, 0, _("Input %d"), number + 1);
-											setFaceString (faceSetting, FACESTR_WIN, 0, _("Sensor Input %d - Gauge"), number + 1);
-											if (value < 1)
-											{
-												setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Sensor Input %d</b>: %0.0f mV\n"
-														"<b>Chipset Name</b>: %s"), number + 1, value * 1000, chipset -> prefix);
-												setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.0f mV"), value * 1000);
-											}
-											else
-											{
-												setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Sensor Input %d</b>: %0.2f V\n"
-														"<b>Chipset Name</b>: %s"), number + 1, value, chipset -> prefix);
-												setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.2f V"), value);
-											}
-											faceSetting -> firstValue = value;
-											while (faceSetting -> firstValue > faceSetting -> faceScaleMax)
-											{
-												if (faceSetting -> faceScaleMax == 1)
-												{
-													faceSetting -> faceScaleMax = 6;
-												}
-												else
-												{
-													faceSetting -> faceScaleMax += 6;
-												}
-												maxMinReset (&faceSetting -> savedMaxMin, 10, 2);
-											}
-										}
-										break;
-									}
-									return;
-								}
+				case FACE_TYPE_SENSOR_INPUT:
+					if (gaugeEnabled[FACE_TYPE_SENSOR_INPUT].enabled)
+					{
+						setFaceString (faceSetting, FACESTR_TOP, 0, _("Input %d"), number + 1);
+						setFaceString (faceSetting, FACESTR_WIN, 0, _("Sensor Input %d - Gauge"), number + 1);
+						if (value < 1)
+						{
+							setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Sensor Input %d</b>: %0.0f mV\n"
+									"<b>Chipset Name</b>: %s"), number + 1, value * 1000, prefix);
+							setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.0f mV"), value * 1000);
+						}
+						else
+						{
+							setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Sensor Input %d</b>: %0.2f V\n"
+									"<b>Chipset Name</b>: %s"), number + 1, value, prefix);
+							setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.2f V"), value);
+						}
+						faceSetting -> firstValue = value;
+						while (faceSetting -> firstValue > faceSetting -> faceScaleMax)
+						{
+							if (faceSetting -> faceScaleMax == 1)
+							{
+								faceSetting -> faceScaleMax = 6;
+							}
+							else
+							{
+								faceSetting -> faceScaleMax += 6;
 							}
+							maxMinReset (&faceSetting -> savedMaxMin, 10, 2);
 						}
-						subfeature = sensors_get_all_subfeatures (chipset, feature, &nr2);
 					}
-					feature = sensors_get_features (chipset, &nr1);
+					break;
 				}
-				chipset = sensors_get_detected_chips (NULL, &nr);
+				return;
 			}
 		}
 #endif
@@ -395,12 +461,13 @@ void readSensorValues (int face)
 		{
 			if (faceSetting -> faceSubType == 15)
 			{
-				FILE *thermFile = fopen (sysThermalFile, "r");
-				if (thermFile != NULL)
+				char *ptr = samplerRead (&thermalFile);
+				if (ptr != NULL)
 				{
-					int readTemp;
-					if (fscanf(thermFile, "%d", &readTemp) == 1)
+					if (*ptr == '-' || (*ptr >= '0' && *ptr <= '9'))
 					{
+						int readTemp = (int)samplerReadNumber (&ptr);
+
 						faceSetting -> firstValue = (float)readTemp / 1000;
 						setFaceString (faceSetting, FACESTR_TOP, 0, _("System\nTemp"));
 						setFaceString (faceSetting, FACESTR_WIN, 0, _("System Temp %0.1f - Gauge"), 
@@ -414,7 +481,6 @@ void readSensorValues (int face)
 							maxMinReset (&faceSetting -> savedMaxMin, 10, 2);
 						}
 					}
-					fclose (thermFile);
 				}
 			}
 		}
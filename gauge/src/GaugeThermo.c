@@ -62,6 +62,22 @@ typedef struct _thermoReading
 }
 ThermoReading;
 
+/*----------------------------------------------------------------------------------------------------*
+ * The reader thread fills in a sample and passes it to the main loop, which passes it back when done *
+ *----------------------------------------------------------------------------------------------------*/
+typedef struct _thermoSample
+{
+	double value[THERMO_MAX_READING];
+	char showValue[THERMO_MAX_READING][21];
+	time_t readTime;
+}
+THERMO_SAMPLE;
+
+static THERMO_SAMPLE thermoSamples[2];
+static THERMO_SAMPLE *spareSample = NULL;		/* Only used by the reader thread */
+static void *sampleQueue = NULL;
+static void *freeQueue = NULL;
+
 ThermoReading myThermoReading[THERMO_MAX_READING] =
 {
 	{ "outside", "Outside", "%0.1f\302\260C", 0, "NA" },
@@ -84,6 +100,11 @@ ThermoReading myThermoReading[THERMO_MAX_READING] =
  */
 void readThermometerInit (void)
 {
+	if ((sampleQueue = queueCreateSPSC (2)) != NULL && (freeQueue = queueCreateSPSC (2)) != NULL)
+	{
+		queuePut (freeQueue, &thermoSamples[0]);
+		queuePut (freeQueue, &thermoSamples[1]);
+	}
 	if (gaugeEnabled[FACE_TYPE_THERMO].enabled)
 	{
 		int clientSock = ConnectClientSocket (thermoServer, thermoPort, 3, USE_ANY, NULL);
@@ -103,12 +124,13 @@ void readThermometerInit (void)
  **********************************************************************************************************************/
 /**
  *  \brief Process each of the fields in the XML.
+ *  \param sample Save the readings here.
  *  \param readLevel 0 current, 1 today, 2 tomorrow.
  *  \param name Name of the field.
  *  \param value Value of the field.
  *  \result None.
  */
-static void processThermoKey (int readLevel, const char *name, char *value)
+static void processThermoKey (THERMO_SAMPLE *sample, int readLevel, const char *name, char *value)
 {
 	int i;
 	for (i = 0; i < THERMO_MAX_READING; ++i)
@@ -117,8 +139,8 @@ static void processThermoKey (int readLevel, const char *name, char *value)
 		{
 			if (strcmp (name, myThermoReading[i].name) == 0)
 			{
-				myThermoReading[i].value = atof (value);
-				sprintf (myThermoReading[i].showValue, myThermoReading[i].format, myThermoReading[i].value);
+				sample -> value[i] = atof (value);
+				sprintf (sample -> showValue[i], myThermoReading[i].format, sample -> value[i]);
 			}
 		}
 	}
@@ -132,12 +154,13 @@ static void processThermoKey (int readLevel, const char *name, char *value)
  **********************************************************************************************************************/
 /**
  *  \brief Process each of the elements in the file.
+ *  \param sample Save the readings here.
  *  \param doc Document to read.
  *  \param aNode Current node.
  *  \param readLevel 0 current, 1 today, 2 tomorrow.
  *  \result None.
  */
-static void processElementNames (xmlDoc *doc, xmlNode * aNode, int readLevel)
+static void processElementNames (THERMO_SAMPLE *sample, xmlDoc *doc, xmlNode * aNode, int readLevel)
 {
 	xmlChar *key;
 	xmlNode *curNode = NULL;
@@ -149,16 +172,16 @@ static void processElementNames (xmlDoc *doc, xmlNode * aNode, int readLevel)
 			if ((!xmlStrcmp (curNode -> name, (const xmlChar *)"sensors")))
 			{
 				++readLevel;
-				lastRead = time (NULL);
+				sample -> readTime = time (NULL);
 			}
 			else
 			{
 				key = xmlNodeListGetString (doc, curNode -> xmlChildrenNode, 1);
-				processThermoKey (readLevel, (const char *)curNode -> name, (char *)key);
+				processThermoKey (sample, readLevel, (const char *)curNode -> name, (char *)key);
 				xmlFree (key);
 			}
 		}
-		processElementNames (doc, curNode->children, readLevel);
+		processElementNames (sample, doc, curNode->children, readLevel);
 	}
 }
 
@@ -170,11 +193,12 @@ static void processElementNames (xmlDoc *doc, xmlNode * aNode, int readLevel)
  **********************************************************************************************************************/
 /**
  *  \brief Process the down loaded buffer.
+ *  \param sample Save the readings here.
  *  \param buffer Buffer to process.
  *  \param size Size of the buffer.
  *  \result None.
  */
-static void processBuffer (char *buffer, size_t size)
+static void processBuffer (THERMO_SAMPLE *sample, char *buffer, size_t size)
 {
 	xmlDoc *doc = NULL;
 	xmlNode *rootElement = NULL;
@@ -188,7 +212,7 @@ static void processBuffer (char *buffer, size_t size)
 		if (doc != NULL)
 		{
 			rootElement = xmlDocGetRootElement (doc);
-			processElementNames (doc, rootElement, 0);
+			processElementNames (sample, doc, rootElement, 0);
 			xmlFreeDoc (doc);
 		}
 		else
@@ -215,25 +239,48 @@ void *readThermometerInfo (void *notUsed)
 {
 	char buffer[512] = "";
 	int bytesRead = 0;
+	THERMO_SAMPLE *sample;
 
 	thermoState = THERMO_STATE_PENDING;
+
+	/*------------------------------------------------------------------------------------------------*
+     * Both samples are waiting to be shown, so nothing to fill in. A sample kept from a failed read  *
+     * is used again, only the main loop puts samples back on the free queue.                         *
+     *------------------------------------------------------------------------------------------------*/
+	if ((sample = spareSample) == NULL && (freeQueue == NULL || (sample = queueGet (freeQueue)) == NULL))
+	{
+		thermoState = THERMO_STATE_UPDATED;
+		return NULL;
+	}
+
 	int clientSock = ConnectClientSocket (thermoServer, thermoPort, 3, USE_ANY, NULL);
 	if (SocketValid (clientSock))
 	{
 		int i;
 		for (i = 0; i < THERMO_MAX_READING; ++i)
 		{
-			strcpy (myThermoReading[i].showValue, "NA");
+			sample -> value[i] = 0;
+			strcpy (sample -> showValue[i], "NA");
 		}
+		sample -> readTime = 0;
 		if (WaitSocket (clientSock, 2) > 0)
 		{
 			bytesRead = RecvSocket (clientSock, buffer, 511);
 		}
 		CloseSocket (&clientSock);
+		if (bytesRead)
+		{
+			processBuffer (sample, buffer, bytesRead);
+		}
+		spareSample = NULL;
+		queuePut (sampleQueue, sample);
+	}
+	else
+	{
+		spareSample = sample;
 	}
 	if (bytesRead)
 	{
-		processBuffer (buffer, bytesRead);
 		thermoStart = 0;
 		thermoState = THERMO_STATE_UPDATED;
 	}
@@ -283,6 +330,25 @@ void readThermometerValues (int face)
 	{
 		char readTimeStr[81] = "Never";
 		FACE_SETTINGS *faceSetting = faceSettings[face];
+		THERMO_SAMPLE *sample;
+
+		/*--------------------------------------------------------------------------------------------*
+         * Pick up any samples from the reader thread                                                 *
+         *--------------------------------------------------------------------------------------------*/
+		while (sampleQueue != NULL && (sample = queueGet (sampleQueue)) != NULL)
+		{
+			int i;
+			for (i = 0; i < THERMO_MAX_READING; ++i)
+			{
+				myThermoReading[i].value = sample -> value[i];
+				strcpy (myThermoReading[i].showValue, sample -> showValue[i]);
+			}
+			if (sample -> readTime)
+			{
+				lastRead = sample -> readTime;
+			}
+			queuePut (freeQueue, sample);
+		}
 
 		if (faceSetting -> faceFlags & FACE_REDRAW)
 		{
@@ -296,7 +362,7 @@ void readThermometerValues (int face)
 		else if (!faceSetting -> nextUpdate)
 		{
 			startUpdateThermoInfo ();
-			faceSetting -> nextUpdate = (thermoStart ? 5 : 120);
+			faceSetting -> nextUpdate = (thermoStart ? 1 : 24);
 		}
 		if (lastRead != 0)
 		{
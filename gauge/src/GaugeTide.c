@@ -74,6 +74,10 @@ struct TideInfo
 
 static struct TideInfo tideInfo;
 static int lastReadTide;
+static struct TideInfo readTide;		/* Only used by the reader thread until it is queued */
+static int readLastTide;
+static void *tideQueue = NULL;
+static int tideDiscard = 0;
 
 static int myUpdateID = -1;
 static time_t tideDuration = 22358;
@@ -233,7 +237,7 @@ void scanDateTime (int index, const char *strValue)
 		}
 		if (strValue[i] == 0)
 		{
-			tideInfo.tideTimes[index].tideTime = mktime(&tideTime);
+			readTide.tideTimes[index].tideTime = mktime(&tideTime);
 			break;
 		}
 		++i;
@@ -292,7 +296,7 @@ void displayValue (char *name, int index, GValue *value)
 			const char *strValue = g_value_get_string (value);
 			if (strcmp (name, "EventType") == 0)
 			{
-				tideInfo.tideTimes[index].tideType = strValue[0];
+				readTide.tideTimes[index].tideType = strValue[0];
 			}
 			else if (strcmp (name, "DateTime") == 0)
 			{
@@ -300,20 +304,20 @@ void displayValue (char *name, int index, GValue *value)
 			}
 			else if (strcmp (name, "Date") == 0)
 			{
-				tideInfo.tideTimes[index].tideSet = 1;
-				tideInfo.readTime = getLocalNextMidday();
-				lastReadTide = index;
+				readTide.tideTimes[index].tideSet = 1;
+				readTide.readTime = getLocalNextMidday();
+				readLastTide = index;
 			}
 			else if (strcmp (name, "Name") == 0)
 			{
-				strcpy (tideInfo.location, strValue);
-				properCaseWord (tideInfo.location);
-				tideInfo.locRead = 1;
+				strcpy (readTide.location, strValue);
+				properCaseWord (readTide.location);
+				readTide.locRead = 1;
 			}
 			else if (strcmp (name, "Country") == 0)
 			{
-				strcpy (tideInfo.country, strValue);
-				properCaseWord (tideInfo.country);
+				strcpy (readTide.country, strValue);
+				properCaseWord (readTide.country);
 			}
 		}
 		else if (G_VALUE_HOLDS (value, G_TYPE_BOOLEAN))
@@ -328,7 +332,7 @@ void displayValue (char *name, int index, GValue *value)
 				double num = g_value_get_double (&number);
 				if (strcmp (name, "Height") == 0)
 				{
-					tideInfo.tideTimes[index].tideHeight = num;
+					readTide.tideTimes[index].tideHeight = num;
 				}
 			}
 			g_value_unset (&number);
@@ -461,7 +465,7 @@ static void processBuffer (char *buffer, size_t size)
 	}
 	else
 	{
-		lastReadTide = 0;
+		readLastTide = 0;
 		root = json_parser_get_root (parser);
 		if (root != NULL)
 		{
@@ -513,7 +517,7 @@ void *getTideTimes (void *arg)
 	{
 		strcpy (apiKey, "Ocp-Apim-Subscription-Key: ");
 		strcat (apiKey, tideAPIKey);
-		if (tideInfo.locRead == 0)
+		if (readTide.locRead == 0)
 		{
 			curl_easy_setopt (curlHandle, CURLOPT_URL, &tideURL[0]);
 			curl_easy_setopt (curlHandle, CURLOPT_WRITEFUNCTION, writeMemoryCallback);
@@ -529,11 +533,10 @@ void *getTideTimes (void *arg)
 			{
 				if (chunk.size)
 				{
-					memset (&tideInfo, 0, sizeof (tideInfo));
+					memset (&readTide, 0, sizeof (readTide));
 					processBuffer (chunk.memory, chunk.size);
 				}
 			}
-			tideState = TIDE_STATE_UPDATED;
 		}
 		else
 		{
@@ -556,11 +559,11 @@ void *getTideTimes (void *arg)
 					processBuffer (chunk.memory, chunk.size);
 				}
 			}
-			tideState = TIDE_STATE_UPDATED;
 		}
 		curl_global_cleanup();
 	}
 	free(chunk.memory);
+	queuePut (tideQueue, &readTide);
 	return NULL;
 }
 
@@ -576,15 +579,57 @@ void *getTideTimes (void *arg)
  */
 void startUpdateTideInfo()
 {
+	if (tideQueue == NULL && (tideQueue = queueCreateSPSC (2)) == NULL)
+	{
+		return;
+	}
 	if (tideState != TIDE_STATE_PENDING)
 	{
+		/*--------------------------------------------------------------------------------------------*
+         * The reader thread works on its own copy, the main loop takes it back when it is queued.    *
+         *--------------------------------------------------------------------------------------------*/
+		readTide = tideInfo;
+		readLastTide = lastReadTide;
 		if (pthread_create (&threadHandle, NULL, getTideTimes, NULL) == 0)
 		{
+			tideDiscard = 0;
 			tideState = TIDE_STATE_PENDING;
 		}
 	}
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  C H E C K  T I D E  U P D A T E                                                                                   *
+ *  ===============================                                                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Pick up the tide times read by the reader thread, only called from the main loop.
+ *  \result None.
+ */
+static void checkTideUpdate (void)
+{
+	struct TideInfo *update;
+
+	if (tideQueue == NULL || (update = queueGet (tideQueue)) == NULL)
+	{
+		return;
+	}
+	pthread_join (threadHandle, NULL);
+	if (tideDiscard)
+	{
+		myUpdateID = -1;
+	}
+	else
+	{
+		tideInfo = *update;
+		lastReadTide = readLastTide;
+	}
+	tideDiscard = 0;
+	tideState = TIDE_STATE_UPDATED;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  R E A D  T I D E  I N I T                                                                                         *
@@ -627,15 +672,7 @@ void readTideValues (int face)
 		int i, nextTide, loopStart, loopEnd;
 		long duration;
 
-		if (faceSetting -> faceFlags & FACE_REDRAW)
-		{
-			;
-		}
-		else if (sysUpdateID % 10 != 0 && myUpdateID != -1)
-		{
-			return;
-		}
-
+		checkTideUpdate ();
 		if (myUpdateID != sysUpdateID)
 		{
 			time_t now = time (NULL);
@@ -792,6 +829,10 @@ void tideSettings (guint data)
 		}
 		if (saved)
 		{
+			if (tideState == TIDE_STATE_PENDING)
+			{
+				tideDiscard = 1;
+			}
 			tideInfo.locRead = 0;
 			startUpdateTideInfo ();
 			myUpdateID = -1;
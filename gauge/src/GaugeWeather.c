@@ -193,6 +193,10 @@ typedef struct
 weatherInfo;
 
 weatherInfo myWeather;
+static weatherInfo readWeather;		/* Only used by the reader thread until it is queued */
+static char readLocation[41];
+static void *weatherQueue = NULL;
+static int weatherDiscard = 0;
 
 /**********************************************************************************************************************
  *                                                                                                                    *
@@ -209,24 +213,24 @@ weatherInfo myWeather;
  */
 int updateChange(int val, int newVal, int oldVal)
 {
-	if (myWeather.updateNum != -1)
+	if (readWeather.updateNum != -1)
 	{
 		if (newVal > oldVal)
 		{
-			myWeather.changed[val][0] = 1;
-			myWeather.changed[val][1] = 8;
+			readWeather.changed[val][0] = 1;
+			readWeather.changed[val][1] = 8;
 		}
 		else if (newVal < oldVal)
 		{
-			myWeather.changed[val][0] = -1;
-			myWeather.changed[val][1] = 8;
+			readWeather.changed[val][0] = -1;
+			readWeather.changed[val][1] = 8;
 		}
 		else
 		{
-			if (myWeather.changed[val][1])
-				myWeather.changed[val][1] = myWeather.changed[val][1] - 1;
+			if (readWeather.changed[val][1])
+				readWeather.changed[val][1] = readWeather.changed[val][1] - 1;
 			else
-				myWeather.changed[val][0] = 0;
+				readWeather.changed[val][0] = 0;
 		}
 	}
 	return newVal;
@@ -434,7 +438,7 @@ void splitOutTitle(char *value)
 		{
 			if (value[i] == ',')
 			{
-				strncpy(myWeather.weatherDesc, buffer, 81);
+				strncpy(readWeather.weatherDesc, buffer, 81);
 				break;
 			}
 			buffer[c] = value[i];
@@ -486,8 +490,8 @@ void splitOutForcastTitle(char *value, int level)
 							strcmp (daysOfWeek[n], &buffers[0][0]) == 0)
 					{
 						buffers[0][20] = buffers[1][80] = 0;
-						strcpy(myWeather.forecast[level - 1].date, &buffers[0][0]);
-						strcpy(myWeather.forecast[level - 1].weatherDesc, &buffers[1][0]);
+						strcpy(readWeather.forecast[level - 1].date, &buffers[0][0]);
+						strcpy(readWeather.forecast[level - 1].weatherDesc, &buffers[1][0]);
 						break;
 					}
 				}
@@ -532,7 +536,7 @@ void splitOutDescription(char *value, int level)
 	buffers[0][0] = buffers[1][0] = 0;
 	if (!observations)
 	{
-		myWeather.forecast[level - 1].evening = 1;
+		readWeather.forecast[level - 1].evening = 1;
 	}
 	while (1)
 	{
@@ -548,22 +552,22 @@ void splitOutDescription(char *value, int level)
 				/* &buffers[0][0], &buffers[1][0]); */
 				if (strcmp(&buffers[0][0], "Temperature") == 0)
 				{
-					myWeather.tempC =
-						updateChange(CHNG_TEMP, atoi(&buffers[1][0]), myWeather.tempC);
+					readWeather.tempC =
+						updateChange(CHNG_TEMP, atoi(&buffers[1][0]), readWeather.tempC);
 				}
 				else if (strcmp(&buffers[0][0], "Maximum Temperature") == 0)
 				{
 					if (!observations)
 					{
-						myWeather.forecast[level - 1].tempMaxC = atoi(&buffers[1][0]);
-						myWeather.forecast[level - 1].evening = 0;
+						readWeather.forecast[level - 1].tempMaxC = atoi(&buffers[1][0]);
+						readWeather.forecast[level - 1].evening = 0;
 					}
 				}
 				else if (strcmp(&buffers[0][0], "Minimum Temperature") == 0)
 				{
 					if (!observations)
 					{
-						myWeather.forecast[level - 1].tempMinC = atoi(&buffers[1][0]);
+						readWeather.forecast[level - 1].tempMinC = atoi(&buffers[1][0]);
 					}
 				}
 				else if (strcmp(&buffers[0][0], "Wind Speed") == 0)
@@ -573,20 +577,20 @@ void splitOutDescription(char *value, int level)
 					{
 						if (strncmp (&buffers[1][0], "--", 2))
 						{
-							myWeather.windspeedmph = updateChange(CHNG_WIND, speed, myWeather.windspeedmph);
-							myWeather.windspeedKmph = speed * 1.609344;
+							readWeather.windspeedmph = updateChange(CHNG_WIND, speed, readWeather.windspeedmph);
+							readWeather.windspeedKmph = speed * 1.609344;
 						}
 						else
 						{
-							myWeather.windspeedmph = 
-									updateChange(CHNG_WIND, myWeather.forecast[0].windspeedmph, myWeather.windspeedmph);
-							myWeather.windspeedKmph = myWeather.forecast[0].windspeedKmph;
+							readWeather.windspeedmph = 
+									updateChange(CHNG_WIND, readWeather.forecast[0].windspeedmph, readWeather.windspeedmph);
+							readWeather.windspeedKmph = readWeather.forecast[0].windspeedKmph;
 						}
 					}
 					else
 					{
-						myWeather.forecast[level - 1].windspeedmph = speed;
-						myWeather.forecast[level - 1].windspeedKmph = speed * 1.609344;
+						readWeather.forecast[level - 1].windspeedmph = speed;
+						readWeather.forecast[level - 1].windspeedKmph = speed * 1.609344;
 					}
 				}
 				else if (strcmp(&buffers[0][0], "Pressure") == 0)
@@ -596,17 +600,17 @@ void splitOutDescription(char *value, int level)
 					{
 						if (strncmp (&buffers[1][0], "--", 2))
 						{
-							myWeather.pressure = updateChange(CHNG_PRES, press, myWeather.pressure);
+							readWeather.pressure = updateChange(CHNG_PRES, press, readWeather.pressure);
 						}
 						else
 						{
-							myWeather.pressure = 
-									updateChange(CHNG_PRES, myWeather.forecast[0].pressure, myWeather.pressure);
+							readWeather.pressure = 
+									updateChange(CHNG_PRES, readWeather.forecast[0].pressure, readWeather.pressure);
 						}
 					}
 					else
 					{
-						myWeather.forecast[level - 1].pressure = press;
+						readWeather.forecast[level - 1].pressure = press;
 					}
 				}
 				else if (strcmp(&buffers[0][0], "Humidity") == 0)
@@ -616,17 +620,17 @@ void splitOutDescription(char *value, int level)
 					{
 						if (strncmp (&buffers[1][0], "--", 2))
 						{
-							myWeather.humidity = updateChange(CHNG_HUMI, humid, myWeather.humidity);
+							readWeather.humidity = updateChange(CHNG_HUMI, humid, readWeather.humidity);
 						}
 						else
 						{
-							myWeather.humidity = 
-									updateChange(CHNG_HUMI, myWeather.forecast[0].humidity, myWeather.humidity);
+							readWeather.humidity = 
+									updateChange(CHNG_HUMI, readWeather.forecast[0].humidity, readWeather.humidity);
 						}
 					}
 					else
 					{
-						myWeather.forecast[level - 1].humidity = humid;
+						readWeather.forecast[level - 1].humidity = humid;
 					}
 				}
 				else if (strcmp(&buffers[0][0], "Wind Direction") == 0)
@@ -634,12 +638,12 @@ void splitOutDescription(char *value, int level)
 					if (observations)
 					{
 						buffers[1][20] = 0;
-						strcpy(myWeather.winddirPoint, &buffers[1][0]);
+						strcpy(readWeather.winddirPoint, &buffers[1][0]);
 					}
 					else
 					{
 						buffers[1][20] = 0;
-						strcpy(myWeather.forecast[level - 1].winddirPoint, &buffers[1][0]);
+						strcpy(readWeather.forecast[level - 1].winddirPoint, &buffers[1][0]);
 					}
 				}
 				else if (strcmp(&buffers[0][0], "Visibility") == 0)
@@ -647,12 +651,12 @@ void splitOutDescription(char *value, int level)
 					if (observations)
 					{
 						buffers[1][20] = 0;
-						strcpy(myWeather.visView, &buffers[1][0]);
+						strcpy(readWeather.visView, &buffers[1][0]);
 					}
 					else
 					{
 						buffers[1][20] = 0;
-						strcpy(myWeather.forecast[level - 1].visView, &buffers[1][0]);
+						strcpy(readWeather.forecast[level - 1].visView, &buffers[1][0]);
 					}
 				}
 				else if (strcmp(&buffers[0][0], "Pollution") == 0)
@@ -660,20 +664,20 @@ void splitOutDescription(char *value, int level)
 					if (!observations)
 					{
 						buffers[1][20] = 0;
-						strcpy(myWeather.forecast[level - 1].pollution, &buffers[1][0]);
+						strcpy(readWeather.forecast[level - 1].pollution, &buffers[1][0]);
 					}
 				}
 				else if (strcmp(&buffers[0][0], "UV Risk") == 0)
 				{
 					if (!observations)
-						myWeather.forecast[level - 1].uvRisk = atoi(&buffers[1][0]);
+						readWeather.forecast[level - 1].uvRisk = atoi(&buffers[1][0]);
 				}
 				else if (strcmp(&buffers[0][0], "Sunrise") == 0)
 				{
 					if (!observations)
 					{
 						buffers[1][20] = 0;
-						strcpy(myWeather.forecast[level - 1].sunrise, &buffers[1][0]);
+						strcpy(readWeather.forecast[level - 1].sunrise, &buffers[1][0]);
 					}
 				}
 				else if (strcmp(&buffers[0][0], "Sunset") == 0)
@@ -681,7 +685,7 @@ void splitOutDescription(char *value, int level)
 					if (!observations)
 					{
 						buffers[1][20] = 0;
-						strcpy(myWeather.forecast[level - 1].sunset, &buffers[1][0]);
+						strcpy(readWeather.forecast[level - 1].sunset, &buffers[1][0]);
 					}
 				}
 			}
@@ -727,7 +731,7 @@ static void processWeatherKey(int readLevel, const char *name, char *value)
 	else if (observations == 0 && readLevel == 0 && strcmp(name, "title") == 0)
 	{
 		if (strncmp(titleStr, value, strlen(titleStr)) == 0)
-			strncpy(myWeather.queryName, &value[strlen(titleStr)], 80);
+			strncpy(readWeather.queryName, &value[strlen(titleStr)], 80);
 	}
 	else if (observations == 1 && readLevel == 1 && strcmp(name, "title") == 0)
 	{
@@ -743,11 +747,11 @@ static void processWeatherKey(int readLevel, const char *name, char *value)
 	{
 		if (observations == 1 && readLevel == 0 && value[0] != 0)
 		{
-			strncpy (myWeather.updateTime, value, 60);
+			strncpy (readWeather.updateTime, value, 60);
 		}
 		else if (observations == 0 && (readLevel >= 1 && readLevel <= 3) && value[0] != 0)
 		{
-			strncpy (myWeather.forecast[readLevel - 1].updateTime, value, 60);
+			strncpy (readWeather.forecast[readLevel - 1].updateTime, value, 60);
 		}
 	}
 }
@@ -961,7 +965,7 @@ void doUpdateWeatherInfo(char *weatherURL)
 	curl_global_init(CURL_GLOBAL_ALL);
 	curlHandle = curl_easy_init();
 
-	encodedLoc = curl_easy_escape(curlHandle, locationKey, 0);
+	encodedLoc = curl_easy_escape(curlHandle, readLocation, 0);
 	sprintf(fullURL, weatherURL, encodedLoc);
 	curl_free(encodedLoc);
 
@@ -1003,7 +1007,7 @@ void doUpdateWeatherInfo(char *weatherURL)
  */
 void *updateWeatherInfo (void *arg)
 {
-	myWeather.updateTime[0] = 0;
+	readWeather.updateTime[0] = 0;
 
 	if (observations == 0)
 	{
@@ -1013,19 +1017,17 @@ void *updateWeatherInfo (void *arg)
 	doUpdateWeatherInfo(weatherOBSURL);
 	observations = 0;
 
-	if (myWeather.updateTime[0])
+	if (readWeather.updateTime[0])
 	{
-		myWeather.nextUpdate = time(NULL) + (15 * 60);
-		if (++myWeather.updateNum == 100)
-			myWeather.updateNum = 0;
-
-		fixupShowValues();
+		readWeather.nextUpdate = time(NULL) + (15 * 60);
+		if (++readWeather.updateNum == 100)
+			readWeather.updateNum = 0;
 	}
 	else
 	{
-		myWeather.nextUpdate = time(NULL) + 15;
+		readWeather.nextUpdate = time(NULL) + 15;
 	}
-	myWeather.readState = READ_STATE_UPDATED;
+	queuePut (weatherQueue, &readWeather);
 	return NULL;
 }
 
@@ -1041,15 +1043,63 @@ void *updateWeatherInfo (void *arg)
  */
 void startUpdateWeatherInfo()
 {
+	if (weatherQueue == NULL && (weatherQueue = queueCreateSPSC (2)) == NULL)
+	{
+		return;
+	}
 	if (time(NULL) >= myWeather.nextUpdate)
 	{
+		/*--------------------------------------------------------------------------------------------*
+         * The reader thread works on its own copy, the main loop takes it back when it is queued.    *
+         *--------------------------------------------------------------------------------------------*/
+		readWeather = myWeather;
+		strncpy (readLocation, locationKey, 40);
 		if (pthread_create (&myWeather.threadHandle, NULL, updateWeatherInfo, NULL) == 0)
 		{
+			weatherDiscard = 0;
 			myWeather.readState = READ_STATE_PENDING;
 		}
 	}
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  C H E C K  W E A T H E R  U P D A T E                                                                             *
+ *  =====================================                                                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Pick up the weather read by the reader thread, only called from the main loop.
+ *  \result None.
+ */
+static void checkWeatherUpdate(void)
+{
+	weatherInfo *update;
+
+	if (weatherQueue == NULL || (update = queueGet (weatherQueue)) == NULL)
+	{
+		return;
+	}
+	pthread_join (myWeather.threadHandle, NULL);
+	if (!weatherDiscard)
+	{
+		int tUnits = myWeather.tUnits, pUnits = myWeather.pUnits;
+		int sUnits = myWeather.sUnits, dUnits = myWeather.dUnits;
+
+		myWeather = *update;
+		myWeather.tUnits = tUnits;
+		myWeather.pUnits = pUnits;
+		myWeather.sUnits = sUnits;
+		myWeather.dUnits = dUnits;
+		if (myWeather.updateTime[0])
+		{
+			fixupShowValues();
+		}
+	}
+	weatherDiscard = 0;
+	myWeather.readState = READ_STATE_UPDATED;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  W E A T H E R  G E T  M A X  M I N                                                                                *
@@ -1139,6 +1189,7 @@ void readWeatherValues(int face)
 		FACE_SETTINGS *faceSetting = faceSettings[face];
 		int subType = faceSetting->faceSubType & 0x0007, i;
 
+		checkWeatherUpdate();
 		if (myWeather.message)
 		{
 			char *showMsg = myWeather.message;
@@ -1158,7 +1209,7 @@ void readWeatherValues(int face)
 		}
 		else if (faceSetting->nextUpdate == 0)
 		{
-			faceSetting->nextUpdate = 20;
+			faceSetting->nextUpdate = 4;
 			if (myWeather.updateNum == faceSetting->updateNum)
 			{
 				if (myWeather.readState == READ_STATE_UPDATED)
@@ -1577,7 +1628,10 @@ void weatherSettings(guint data)
 		if (textUpdate)
 		{
 			weatherGaugeReset();
-			myWeather.readState = READ_STATE_UPDATED;
+			if (myWeather.readState == READ_STATE_PENDING)
+			{
+				weatherDiscard = 1;
+			}
 			myWeather.updateNum = -1;
 			myWeather.nextUpdate = 0;
 		}
@@ -19,20 +19,33 @@
  **********************************************************************************************************************/
 /**
  *  \file
- *  \brief Calculate the wifi quality for the gauge.
+ *  \brief Calculate the wifi quality for the gauge, read from nl80211 or /proc/net/wireless.
  */
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/genetlink.h>
+#include <linux/nl80211.h>
 #include "GaugeDisp.h"
 
+#define MAX_WIFI		4
+#define GENL_BUFFER		16384
+
+/*----------------------------------------------------------------------------------------------------*
+ * Walk the attributes in a generic netlink message, the same as RTA_OK and RTA_NEXT.                 *
+ *----------------------------------------------------------------------------------------------------*/
+#define ATTR_OK(attr,len)	((len) >= (int)NLA_HDRLEN && (attr) -> nla_len >= NLA_HDRLEN && (attr) -> nla_len <= (len))
+#define ATTR_NEXT(attr,len)	((len) -= NLA_ALIGN ((attr) -> nla_len), (struct nlattr *)((char *)(attr) + NLA_ALIGN ((attr) -> nla_len)))
+#define ATTR_DATA(attr)		((void *)((char *)(attr) + NLA_HDRLEN))
+#define ATTR_TYPE(attr)		((attr) -> nla_type & NLA_TYPE_MASK)
+
 extern FACE_SETTINGS *faceSettings[];
 extern GAUGE_ENABLED gaugeEnabled[];
 extern MENU_DESC gaugeMenuDesc[];
-extern int sysUpdateID;
-
-static char *findQualityStr = "Link Quality=";
-static char *findSignalStr = "Signal level=";
-static char *findBitRateStr = "Bit Rate=";
+extern MENU_DESC wifiDevDesc[];
 
 struct sReadInfo
 {
@@ -44,89 +57,385 @@ struct sReadInfo
 	char rateType[11];
 };
 
+struct sWifiInfo
+{
+	struct sReadInfo readInfo[MAX_WIFI];
+};
+
+static char wifiNames[MAX_WIFI][IFNAMSIZ];
+static int wifiIndex[MAX_WIFI];
+static int wifiCount;
+static SAMPLE_JOB *wifiJob;
+static SAMPLE_FILE wirelessFile = { "/proc/net/wireless", -1 };
+
+/*----------------------------------------------------------------------------------------------------*
+ * The generic netlink socket is kept open, -2 means nl80211 cannot be used so use /proc.             *
+ *----------------------------------------------------------------------------------------------------*/
+static int genlSocket = -1;
+static int nl80211Family;
+static unsigned int genlSeq;
+static char *genlBuffer;
+
 /**********************************************************************************************************************
  *                                                                                                                    *
- *  H U N T  F O R  Q U A L I T Y                                                                                     *
- *  =============================                                                                                     *
+ *  G E N L  R E Q U E S T                                                                                            *
+ *  ======================                                                                                            *
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
- *  \brief Search for a matching string in a string.
- *  \param inStr String to search in.
- *  \param findStr String to look for.
- *  \result -1 not found.
+ *  \brief Send a generic netlink request with one optional attribute.
+ *  \param family Family to send to.
+ *  \param command Command to send.
+ *  \param flags Extra netlink flags, NLM_F_DUMP for a dump.
+ *  \param attrType Type of the attribute, 0 for none.
+ *  \param attrData Value of the attribute.
+ *  \param attrLen Length of the attribute.
+ *  \result 1 if sent, 0 on error.
  */
-int huntForQuality (char *inStr, char *findStr)
+static int genlRequest (int family, int command, int flags, int attrType, void *attrData, int attrLen)
 {
-	int matched = 0, len = strlen (findStr), i = 0;
+	char request[NLMSG_LENGTH (GENL_HDRLEN) + NLA_HDRLEN + NLA_ALIGN (GENL_NAMSIZ)];
+	struct nlmsghdr *header = (struct nlmsghdr *)request;
+	struct genlmsghdr *genlHeader = (struct genlmsghdr *)NLMSG_DATA (header);
 
-	while (inStr[i] != 0 && matched < len)
+	memset (request, 0, sizeof (request));
+	header -> nlmsg_len = NLMSG_LENGTH (GENL_HDRLEN);
+	header -> nlmsg_type = family;
+	header -> nlmsg_flags = NLM_F_REQUEST | flags;
+	header -> nlmsg_seq = ++genlSeq;
+	genlHeader -> cmd = command;
+	genlHeader -> version = 1;
+
+	if (attrType && attrLen <= GENL_NAMSIZ)
+	{
+		struct nlattr *attr = (struct nlattr *)(request + header -> nlmsg_len);
+		attr -> nla_type = attrType;
+		attr -> nla_len = NLA_HDRLEN + attrLen;
+		memcpy (ATTR_DATA (attr), attrData, attrLen);
+		header -> nlmsg_len += NLA_ALIGN (attr -> nla_len);
+	}
+	return send (genlSocket, request, header -> nlmsg_len, 0) == header -> nlmsg_len;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  G E N L  R E C E I V E                                                                                            *
+ *  ======================                                                                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the replies to the last request, calling a function for each message.
+ *  \param parseFunc Function to call with the attributes of each message.
+ *  \param userData Passed on to the function.
+ *  \result 1 if all the replies were read, 0 on error.
+ */
+static int genlReceive (void (*parseFunc) (struct nlattr *attr, int attrLen, void *userData), void *userData)
+{
+	while (1)
 	{
-		int retry;
-		do
+		struct nlmsghdr *header;
+		int readLen = recv (genlSocket, genlBuffer, GENL_BUFFER, 0), more = 0;
+
+		if (readLen < 0)
 		{
-			retry = 0;
-			if (inStr[i] == findStr[matched])
+			if (errno == EINTR)
+				continue;
+			return 0;
+		}
+		for (header = (struct nlmsghdr *)genlBuffer; NLMSG_OK (header, readLen); header = NLMSG_NEXT (header, readLen))
+		{
+			if (header -> nlmsg_seq != genlSeq)
 			{
-				++matched;
+				more = 1;
+				continue;
 			}
-			else if (matched)
+			if (header -> nlmsg_type == NLMSG_DONE)
+				return 1;
+
+			if (header -> nlmsg_type == NLMSG_ERROR)
+				return ((struct nlmsgerr *)NLMSG_DATA (header)) -> error == 0;
+
+			if (header -> nlmsg_len >= NLMSG_LENGTH (GENL_HDRLEN))
 			{
-				matched = 0;
-				retry = 1;
+				parseFunc ((struct nlattr *)((char *)NLMSG_DATA (header) + GENL_HDRLEN),
+						header -> nlmsg_len - NLMSG_LENGTH (GENL_HDRLEN), userData);
 			}
+			if (header -> nlmsg_flags & NLM_F_MULTI)
+				more = 1;
 		}
-		while (retry);
-		++i;
+		if (!more)
+			return 1;
 	}
-	return (matched == len ? i - len : -1);
 }
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- *  R E A D  L I N K  Q U A L I T Y                                                                                   *
- *  ===============================                                                                                   *
+ *  P A R S E  F A M I L Y                                                                                            *
+ *  ======================                                                                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Pick the family ID out of the reply from the controller.
+ *  \param attr First attribute.
+ *  \param attrLen Length of all the attributes.
+ *  \param userData Not used.
+ *  \result None.
+ */
+static void parseFamily (struct nlattr *attr, int attrLen, void *userData)
+{
+	for (; ATTR_OK (attr, attrLen); attr = ATTR_NEXT (attr, attrLen))
+	{
+		if (ATTR_TYPE (attr) == CTRL_ATTR_FAMILY_ID)
+			nl80211Family = *(unsigned short *)ATTR_DATA (attr);
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  P A R S E  I N T E R F A C E                                                                                      *
+ *  ============================                                                                                      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Save each wireless interface that is a station, these are the ones that can have a quality.
+ *  \param attr First attribute.
+ *  \param attrLen Length of all the attributes.
+ *  \param userData Not used.
+ *  \result None.
+ */
+static void parseInterface (struct nlattr *attr, int attrLen, void *userData)
+{
+	int ifIndex = 0, ifType = -1;
+	char *ifName = NULL;
+
+	for (; ATTR_OK (attr, attrLen); attr = ATTR_NEXT (attr, attrLen))
+	{
+		switch (ATTR_TYPE (attr))
+		{
+		case NL80211_ATTR_IFINDEX:
+			ifIndex = *(unsigned int *)ATTR_DATA (attr);
+			break;
+		case NL80211_ATTR_IFNAME:
+			ifName = (char *)ATTR_DATA (attr);
+			break;
+		case NL80211_ATTR_IFTYPE:
+			ifType = *(unsigned int *)ATTR_DATA (attr);
+			break;
+		}
+	}
+	if (ifIndex && ifName != NULL && ifType == NL80211_IFTYPE_STATION && wifiCount < MAX_WIFI)
+	{
+		strncpy (wifiNames[wifiCount], ifName, IFNAMSIZ - 1);
+		wifiIndex[wifiCount++] = ifIndex;
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  P A R S E  S T A T I O N                                                                                          *
+ *  ========================                                                                                          *
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
- *  \brief Read the link quality by running iwconfig.
- *  \param readInfo Pointer to buffer or read info.
- *  \result 1 if a value was read, 0 if not.
+ *  \brief Read the signal and bit rate of the access point we are connected to.
+ *  \param attr First attribute.
+ *  \param attrLen Length of all the attributes.
+ *  \param userData Read info to fill in.
+ *  \result None.
  */
-int readLinkQuality(struct sReadInfo *readInfo)
+static void parseStation (struct nlattr *attr, int attrLen, void *userData)
 {
-	int retn = 0;
-	char readBuff[1025];
-	FILE *inFile = popen("iwconfig 2>> /dev/null", "r");
+	struct sReadInfo *readInfo = (struct sReadInfo *)userData;
 
-	if (inFile != NULL)
+	for (; ATTR_OK (attr, attrLen); attr = ATTR_NEXT (attr, attrLen))
 	{
-		while (fgets (readBuff, 1024, inFile))
+		if (ATTR_TYPE (attr) == NL80211_ATTR_STA_INFO)
 		{
-			int found = huntForQuality (readBuff, findQualityStr);
-			if (found != -1)
+			struct nlattr *staAttr = (struct nlattr *)ATTR_DATA (attr);
+			int staLen = attr -> nla_len - NLA_HDRLEN;
+
+			for (; ATTR_OK (staAttr, staLen); staAttr = ATTR_NEXT (staAttr, staLen))
 			{
-				int val1, val2;
-				if (sscanf (&readBuff[found + strlen (findQualityStr)], "%d/%d", &val1, &val2) == 2)
+				if (ATTR_TYPE (staAttr) == NL80211_STA_INFO_SIGNAL)
 				{
-					readInfo -> quality = ((double)val1 / (double)val2) * 100;
-					retn = 1;
+					int signal = *(signed char *)ATTR_DATA (staAttr);
+
+					/*--------------------------------------------------------------------------------*
+                     * Same as cfg80211 gives to iwconfig, -110 to -40 dBm is 0 to 70                 *
+                     *--------------------------------------------------------------------------------*/
+					readInfo -> level = signal;
+					signal = signal < -110 ? -110 : signal > -40 ? -40 : signal;
+					readInfo -> quality = ((double)(signal + 110) / 70) * 100;
 				}
+				else if (ATTR_TYPE (staAttr) == NL80211_STA_INFO_TX_BITRATE)
+				{
+					struct nlattr *rateAttr = (struct nlattr *)ATTR_DATA (staAttr);
+					int rateLen = staAttr -> nla_len - NLA_HDRLEN;
+
+					for (; ATTR_OK (rateAttr, rateLen); rateAttr = ATTR_NEXT (rateAttr, rateLen))
+					{
+						if (ATTR_TYPE (rateAttr) == NL80211_RATE_INFO_BITRATE32)
+							readInfo -> rate = (double)*(unsigned int *)ATTR_DATA (rateAttr) / 10;
+						else if (ATTR_TYPE (rateAttr) == NL80211_RATE_INFO_BITRATE && readInfo -> rate == 0)
+							readInfo -> rate = (double)*(unsigned short *)ATTR_DATA (rateAttr) / 10;
+					}
+				}
+			}
+		}
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  O P E N  N L 8 0 2 1 1                                                                                            *
+ *  ======================                                                                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Open the generic netlink socket and look up the nl80211 family.
+ *  \result 1 if nl80211 can be used, 0 if not.
+ */
+static int openNl80211 (void)
+{
+	struct timeval timeout = { 1, 0 };
+
+	if (genlSocket == -1)
+	{
+		genlBuffer = (char *)malloc (GENL_BUFFER);
+		genlSocket = socket (AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_GENERIC);
+		if (genlSocket >= 0 && genlBuffer != NULL)
+		{
+			setsockopt (genlSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof (timeout));
+			if (genlRequest (GENL_ID_CTRL, CTRL_CMD_GETFAMILY, 0, CTRL_ATTR_FAMILY_NAME, NL80211_GENL_NAME,
+					strlen (NL80211_GENL_NAME) + 1))
+			{
+				genlReceive (parseFamily, NULL);
 			}
-			found = huntForQuality (readBuff, findSignalStr);
-			if (found != -1)
+		}
+		if (nl80211Family == 0)
+		{
+			if (genlSocket >= 0)
+				close (genlSocket);
+			genlSocket = -2;
+		}
+	}
+	return genlSocket >= 0;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  P R O C  W I R E L E S S                                                                                 *
+ *  =================================                                                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the quality from /proc/net/wireless, used when nl80211 cannot be used.
+ *  \param wifiInfo Fill in the interfaces we know, NULL to find the interfaces.
+ *  \result Number of interfaces read.
+ */
+static int readProcWireless (struct sWifiInfo *wifiInfo)
+{
+	int found = 0;
+	char *ptr;
+
+	samplerExpire (&wirelessFile);
+	ptr = samplerRead (&wirelessFile);
+
+	while (ptr != NULL && *ptr)
+	{
+		char name[IFNAMSIZ];
+		int i = 0, wifi;
+
+		while (*ptr == ' ')
+			++ptr;
+		while (ptr[i] && ptr[i] != ':' && ptr[i] != '\n' && i < IFNAMSIZ - 1)
+		{
+			name[i] = ptr[i];
+			++i;
+		}
+		name[i] = 0;
+		if (ptr[i] == ':')
+		{
+			ptr += i + 1;
+			if (wifiInfo == NULL)
 			{
-				sscanf (&readBuff[found + strlen (findSignalStr)], "%lf %8s", &readInfo -> level, readInfo -> levelType);
+				if (wifiCount < MAX_WIFI)
+				{
+					strcpy (wifiNames[wifiCount++], name);
+					++found;
+				}
 			}
-			found = huntForQuality (readBuff, findBitRateStr);
-			if (found != -1)
+			else for (wifi = 0; wifi < wifiCount; ++wifi)
 			{
-				sscanf (&readBuff[found + strlen (findBitRateStr)], "%lf %8s", &readInfo -> rate, readInfo -> rateType);
+				if (strcmp (wifiNames[wifi], name) == 0)
+				{
+					struct sReadInfo *readInfo = &wifiInfo -> readInfo[wifi];
+
+					samplerReadNumber (&ptr);
+					readInfo -> quality = (samplerReadFloat (&ptr) / 70) * 100;
+					readInfo -> level = samplerReadFloat (&ptr);
+					readInfo -> rate = 0;
+					++found;
+					break;
+				}
 			}
 		}
-		pclose (inFile);
+		ptr = samplerNextLine (ptr);
+	}
+	return found;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  R E A D  L I N K  Q U A L I T Y                                                                                   *
+ *  ===============================                                                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the link quality of all the wireless interfaces.
+ *  \param wifiInfo Pointer to buffer for the read info.
+ *  \result Number of interfaces read.
+ */
+static int readLinkQuality (struct sWifiInfo *wifiInfo)
+{
+	int wifi, found = 0;
+
+	for (wifi = 0; wifi < wifiCount; ++wifi)
+	{
+		struct sReadInfo *readInfo = &wifiInfo -> readInfo[wifi];
+
+		readInfo -> quality = readInfo -> level = readInfo -> rate = 0;
+		strcpy (readInfo -> levelType, "dBm");
+		strcpy (readInfo -> rateType, "Mb/s");
+	}
+	if (genlSocket < 0)
+		return readProcWireless (wifiInfo);
+
+	for (wifi = 0; wifi < wifiCount; ++wifi)
+	{
+		if (genlRequest (nl80211Family, NL80211_CMD_GET_STATION, NLM_F_DUMP, NL80211_ATTR_IFINDEX, &wifiIndex[wifi], 4) &&
+				genlReceive (parseStation, &wifiInfo -> readInfo[wifi]))
+		{
+			++found;
+		}
 	}
-	return retn;
+	return found;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M P L E  L I N K  Q U A L I T Y                                                                               *
+ *  ===================================                                                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Called on the sampler thread so that reading the link quality does not hold up the display.
+ *  \param snapshot Wifi info to fill in.
+ *  \result None.
+ */
+static void sampleLinkQuality (void *snapshot)
+{
+	readLinkQuality ((struct sWifiInfo *)snapshot);
 }
 
 /**********************************************************************************************************************
@@ -136,17 +445,38 @@ int readLinkQuality(struct sReadInfo *readInfo)
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
- *  \brief Unlock the menu if we can read the wifi quality.
+ *  \brief Find the wireless interfaces and unlock the menu for each one.
  *  \result None.
  */
 void readWifiInit (void)
 {
 	if (gaugeEnabled[FACE_TYPE_WIFI].enabled)
 	{
-		struct sReadInfo readInfo;
-		if (readLinkQuality (&readInfo))
+		int wifi;
+
+		if (openNl80211 ())
+		{
+			if (!genlRequest (nl80211Family, NL80211_CMD_GET_INTERFACE, NLM_F_DUMP, 0, NULL, 0) ||
+					!genlReceive (parseInterface, NULL))
+			{
+				close (genlSocket);
+				genlSocket = -2;
+				wifiCount = 0;
+			}
+		}
+		if (genlSocket < 0)
+		{
+			readProcWireless (NULL);
+		}
+		for (wifi = 0; wifi < wifiCount; ++wifi)
+		{
+			wifiDevDesc[wifi].menuName = wifiNames[wifi];
+			wifiDevDesc[wifi].disable = 0;
+		}
+		if (wifiCount)
 		{
 			gaugeMenuDesc[MENU_GAUGE_WIFI].disable = 0;
+			wifiJob = samplerStartJob (sampleLinkQuality, sizeof (struct sWifiInfo), 2000, 10000);
 		}
 	}
 }
@@ -164,31 +494,34 @@ void readWifiInit (void)
  */
 void readWifiValues (int face)
 {
-	int update = 0;
+	int state, wifi;
 
-	if (gaugeEnabled[FACE_TYPE_MOONPHASE].enabled)
+	if (gaugeEnabled[FACE_TYPE_WIFI].enabled)
 	{
-		struct sReadInfo readInfo;
+		struct sWifiInfo wifiInfo;
+		struct sReadInfo *readInfo;
 		FACE_SETTINGS *faceSetting = faceSettings[face];
 
-		if (faceSetting -> faceFlags & FACE_REDRAW)
-		{
-			faceSetting -> nextUpdate = 5;
-			update = 1;
-		}
-		if (!update && sysUpdateID % 10 != 0)
+		wifi = faceSetting -> faceSubType;
+		if (wifi >= wifiCount)
+			return;
+
+		state = samplerGetSnapshot (wifiJob, &wifiInfo);
+		if (state == SAMPLE_NONE)
 		{
+			setFaceInterval (faceSetting, 200);
 			return;
 		}
-		readLinkQuality (&readInfo);
-		setFaceString (faceSetting, FACESTR_TOP, 0, _("Wifi\nQuality"));
-		setFaceString (faceSetting, FACESTR_WIN, 0, _("Wifi - Gauge"));
-		setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.1f%%"), readInfo.quality);
-		setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Wifi Quality</b>: %0.1f%%\n"
+		readInfo = &wifiInfo.readInfo[wifi];
+		setFaceString (faceSetting, FACESTR_TOP, 0, _("Wifi\n%s"), wifiNames[wifi]);
+		setFaceString (faceSetting, FACESTR_WIN, 0, _("Wifi %s - Gauge"), wifiNames[wifi]);
+		setFaceString (faceSetting, FACESTR_BOT, 0, _("%0.1f%%"), readInfo -> quality);
+		setFaceString (faceSetting, FACESTR_TIP, 0, _("<b>Wifi Quality</b>: %0.1f%% (%s)\n"
 				"<b>Signal Level</b>: %0.0f %s\n"
-				"<b>Bit Rate</b>: %0.0f %s"),
-				readInfo.quality, readInfo.level, readInfo.levelType, readInfo.rate, readInfo.rateType);
-		faceSetting -> firstValue = readInfo.quality;
+				"<b>Bit Rate</b>: %0.1f %s%s"),
+				readInfo -> quality, wifiNames[wifi], readInfo -> level, readInfo -> levelType,
+				readInfo -> rate, readInfo -> rateType, state == SAMPLE_STALE ? _("\n<b>Not responding</b>") : "");
+		faceSetting -> firstValue = readInfo -> quality;
 	}
 }
 
@@ -0,0 +1,259 @@
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  D I A L  B E N C H . C                                                                                            *
+ *  ======================                                                                                            *
+ *                                                                                                                    *
+ *  Copyright (c) 2023 Chris Knight                                                                                   *
+ *                                                                                                                    *
+ *  File DialBench.c part of LibDial is free software: you can redistribute it and/or modify it under the terms of    *
+ *  the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or  *
+ *  (at your option) any later version.                                                                               *
+ *                                                                                                                    *
+ *  LibDial is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied     *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more     *
+ *  details.                                                                                                          *
+ *                                                                                                                    *
+ *  You should have received a copy of the GNU General Public License along with this program. If not, see:           *
+ *  <http://www.gnu.org/licenses/>                                                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \file
+ *  \brief Time the dial drawing primitives on an off screen surface, output is CSV.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <gtk/gtk.h>
+#include "dialsys.h"
+
+/**********************************************************************************************************************
+ * Colours used by the bench, the same layout as the start of the gauge colours.                                      *
+ **********************************************************************************************************************/
+static COLOUR_DETAILS colourNames[] =
+{
+	{	"blk", "Black",				"#000000"	},
+	{	"wht", "White",				"#FFFFFF"	},
+	{	"fce", "Face colour",		"#141414"	},
+	{	"txt", "Text colour",		"#858585"	},
+	{	"hnd", "Hand outer",		"#E0E0E0"	},
+	{	"hnf", "Hand fill",			"#202020"	},
+	{	NULL, NULL, ""	}
+};
+
+static int benchSizes[] = { 64, 128, 256, 512, 1024 };
+static DIAL_CONFIG dialConfig;
+static int benchLoops = 1000;
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  B E N C H  T I M E                                                                                                *
+ *  ==================                                                                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the monotonic clock.
+ *  \result Time in nanoseconds.
+ */
+static double benchTime (void)
+{
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	return ((double)now.tv_sec * 1000000000.0) + (double)now.tv_nsec;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  B E N C H  R E P O R T                                                                                            *
+ *  ======================                                                                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Output one line of results.
+ *  \param name Name of the primitive.
+ *  \param style Style used, or zero.
+ *  \param size Size of the dial.
+ *  \param start Time the run started.
+ *  \result None.
+ */
+static void benchReport (char *name, int style, int size, double start)
+{
+	double taken = benchTime () - start;
+
+	printf ("%s,%d,%d,%d,%.1f\n", name, style, size, benchLoops, taken / benchLoops);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  B E N C H  F A C E                                                                                                *
+ *  ==================                                                                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Draw a whole face the way the gauge and clock do, using only the library.
+ *  \param cr Cairo context to draw on.
+ *  \param cached Use the face cache for the static part.
+ *  \result None.
+ */
+static void benchFace (cairo_t *cr, int cached)
+{
+	int i;
+	char text[21];
+	HAND_STYLE handStyle = { 3, 20, 4, 4, 5, true, false };
+
+	if (cached)
+	{
+		if (!dialDrawStartCached (cr, 0, 0, 0, "bench"))
+		{
+			dialCircleGradient (30, 2, 0);
+			for (i = 0; i < SCALE_4; i += 20)
+				dialDrawMinute (28, i % 100 == 0 ? 2 : 1, i, 3);
+			for (i = 0; i < SCALE_4; i += 100)
+			{
+				sprintf (text, "%d", i / 100);
+				dialDrawMark (i, 24, 4, 5, text);
+			}
+			dialDrawCacheDone ();
+		}
+	}
+	else
+	{
+		dialDrawStart (cr, 0, 0);
+		dialCircleGradient (30, 2, 0);
+		for (i = 0; i < SCALE_4; i += 20)
+			dialDrawMinute (28, i % 100 == 0 ? 2 : 1, i, 3);
+		for (i = 0; i < SCALE_4; i += 100)
+		{
+			sprintf (text, "%d", i / 100);
+			dialDrawMark (i, 24, 4, 5, text);
+		}
+	}
+	dialDrawText (1, "Bench", 3);
+	dialDrawText (2, "12:34", 3);
+	dialDrawHand (137, &handStyle);
+	handStyle.length = 14;
+	dialDrawHand (451, &handStyle);
+	dialDrawFinish ();
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  B E N C H  S I Z E                                                                                                *
+ *  ==================                                                                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Time each of the primitives at one dial size.
+ *  \param size Size of the dial in pixels.
+ *  \result None.
+ */
+static void benchSize (int size)
+{
+	int i, style;
+	double start;
+	cairo_surface_t *surface;
+	cairo_t *cr;
+	static int handStyles[] = { 0, 1, 2, 3, 4, 5, 9 };
+	HAND_STYLE handStyle = { 0, 20, 4, 4, 5, true, false };
+
+	dialConfig.dialSize = size;
+	dialCacheInvalidate ();
+
+	surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, size, size);
+	cr = cairo_create (surface);
+	dialDrawStart (cr, 0, 0);
+
+	for (style = 0; style < sizeof (handStyles) / sizeof (handStyles[0]); ++style)
+	{
+		handStyle.style = handStyles[style];
+		start = benchTime ();
+		for (i = 0; i < benchLoops; ++i)
+			dialDrawHand ((i * 7) % SCALE_4, &handStyle);
+		benchReport ("dialDrawHand", handStyle.style, size, start);
+	}
+
+	for (style = 0; style < 3; ++style)
+	{
+		start = benchTime ();
+		for (i = 0; i < benchLoops; ++i)
+			dialCircleGradient (30, 2, style);
+		benchReport ("dialCircleGradient", style, size, start);
+	}
+
+	for (style = 0; style < 3; ++style)
+	{
+		dialConfig.markerType = style + 1;
+		start = benchTime ();
+		for (i = 0; i < benchLoops; ++i)
+			dialDrawMark ((i % 12) * 100, 24, 4, 5, "12");
+		benchReport ("dialDrawMark", dialConfig.markerType, size, start);
+	}
+
+	start = benchTime ();
+	for (i = 0; i < benchLoops; ++i)
+		dialDrawTextX (size >> 1, size >> 1, "12:34:56", 3, 0);
+	benchReport ("dialDrawTextX", 0, size, start);
+
+	dialDrawFinish ();
+
+	start = benchTime ();
+	for (i = 0; i < benchLoops; ++i)
+		benchFace (cr, 0);
+	benchReport ("face", 0, size, start);
+
+	start = benchTime ();
+	for (i = 0; i < benchLoops; ++i)
+		benchFace (cr, 1);
+	benchReport ("faceCached", 0, size, start);
+
+	cairo_destroy (cr);
+	cairo_surface_destroy (surface);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  M A I N                                                                                                           *
+ *  =======                                                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief The program starts here.
+ *  \param argc Number of arguments.
+ *  \param argv The arguments, an optional loop count then optional sizes.
+ *  \result 0 if all OK.
+ */
+int main (int argc, char *argv[])
+{
+	int i;
+
+	if (argc > 1)
+	{
+		benchLoops = atoi (argv[1]);
+		if (benchLoops < 1) benchLoops = 1;
+	}
+
+	dialConfig.dialSize = benchSizes[0];
+	dialConfig.dialWidth = dialConfig.dialHeight = 1;
+	dialConfig.markerType = 1;
+	dialConfig.markerStep = 100;
+	dialConfig.markerScale = 10;
+	dialConfig.dialGradient = 0;
+	dialConfig.fontName = "Sans 10";
+	dialConfig.colourDetails = colourNames;
+	dialInitOffscreen (&dialConfig);
+
+	printf ("primitive,style,size,loops,ns\n");
+	if (argc > 2)
+	{
+		for (i = 2; i < argc; ++i)
+			benchSize (atoi (argv[i]));
+	}
+	else
+	{
+		for (i = 0; i < sizeof (benchSizes) / sizeof (benchSizes[0]); ++i)
+			benchSize (benchSizes[i]);
+	}
+	return 0;
+}
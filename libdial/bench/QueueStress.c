@@ -0,0 +1,123 @@
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Q U E U E  S T R E S S . C                                                                                        *
+ *  ==========================                                                                                        *
+ *                                                                                                                    *
+ *  Copyright (c) 2023 Chris Knight                                                                                   *
+ *                                                                                                                    *
+ *  File QueueStress.c part of LibDial is free software: you can redistribute it and/or modify it under the terms of  *
+ *  the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or  *
+ *  (at your option) any later version.                                                                               *
+ *                                                                                                                    *
+ *  LibDial is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied     *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more     *
+ *  details.                                                                                                          *
+ *                                                                                                                    *
+ *  You should have received a copy of the GNU General Public License along with this program. If not, see:           *
+ *  <http://www.gnu.org/licenses/>                                                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \file
+ *  \brief Push items through a single producer single consumer queue from one thread to another and check
+ *  every item comes out once and in order.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <gtk/gtk.h>
+#include "dialsys.h"
+
+static void *stressQueue;
+static unsigned long stressItems = 10000000;
+static unsigned long producerFull = 0;
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S T R E S S  P R O D U C E R                                                                                      *
+ *  ============================                                                                                      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Thread that adds the numbers 1 to stressItems to the queue.
+ *  \param notUsed Not used.
+ *  \result NULL.
+ */
+static void *stressProducer (void *notUsed)
+{
+	unsigned long i;
+
+	for (i = 1; i <= stressItems; ++i)
+	{
+		while (!queueTryPut (stressQueue, (void *)(uintptr_t)i))
+		{
+			++producerFull;
+			sched_yield ();
+		}
+	}
+	return NULL;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  M A I N                                                                                                           *
+ *  =======                                                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief The program starts here, the main thread is the consumer.
+ *  \param argc Number of arguments.
+ *  \param argv The arguments, an optional item count then an optional queue size.
+ *  \result 0 if every item arrived in order, 1 if not.
+ */
+int main (int argc, char *argv[])
+{
+	unsigned long expect = 1, queueSize = 64, consumerEmpty = 0;
+	pthread_t producer;
+	void *item;
+
+	if (argc > 1)
+		stressItems = strtoul (argv[1], NULL, 10);
+	if (argc > 2)
+		queueSize = strtoul (argv[2], NULL, 10);
+
+	if ((stressQueue = queueCreateSPSC (queueSize)) == NULL)
+	{
+		fprintf (stderr, "Failed to create the queue\n");
+		return 1;
+	}
+	if (pthread_create (&producer, NULL, stressProducer, NULL) != 0)
+	{
+		fprintf (stderr, "Failed to start the producer\n");
+		return 1;
+	}
+
+	while (expect <= stressItems)
+	{
+		if ((item = queueGet (stressQueue)) == NULL)
+		{
+			++consumerEmpty;
+			sched_yield ();
+			continue;
+		}
+		if ((uintptr_t)item != expect)
+		{
+			fprintf (stderr, "Expected item %lu, got %lu\n", expect, (unsigned long)(uintptr_t)item);
+			return 1;
+		}
+		++expect;
+	}
+	pthread_join (producer, NULL);
+
+	if (queueGet (stressQueue) != NULL)
+	{
+		fprintf (stderr, "Items left on the queue after %lu\n", stressItems);
+		return 1;
+	}
+	queueDelete (stressQueue);
+	printf ("%lu items passed, producer full %lu times, consumer empty %lu times\n",
+			stressItems, producerFull, consumerEmpty);
+	return 0;
+}
@@ -0,0 +1,178 @@
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  T R I G  C H E C K . C                                                                                            *
+ *  ======================                                                                                            *
+ *                                                                                                                    *
+ *  Copyright (c) 2023 Chris Knight                                                                                   *
+ *                                                                                                                    *
+ *  File TrigCheck.c part of LibDial is free software: you can redistribute it and/or modify it under the terms of    *
+ *  the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or  *
+ *  (at your option) any later version.                                                                               *
+ *                                                                                                                    *
+ *  LibDial is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied     *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more     *
+ *  details.                                                                                                          *
+ *                                                                                                                    *
+ *  You should have received a copy of the GNU General Public License along with this program. If not, see:           *
+ *  <http://www.gnu.org/licenses/>                                                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \file
+ *  \brief Check the fixed point sin and cos give exactly what the old floating point tables gave.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gtk/gtk.h>
+#include "dialsys.h"
+
+#define CHECK_RADIUS	1024
+#define CHECK_COUNT		((CHECK_RADIUS * 2) + 1)
+
+static COLOUR_DETAILS colourNames[] =
+{
+	{	NULL, NULL, ""	}
+};
+
+static DIAL_CONFIG dialConfig;
+static double oldSin[SCALE_4], oldCos[SCALE_4];
+static unsigned long checkFailed = 0;
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  F I L L  O L D  T A B L E S                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+
+/**
+ *  \brief Fill the tables the way the library did before it went to fixed point.
+ *  \param startPoint Angle the tables start at.
+ *  \result None.
+ */
+static void fillOldTables (int startPoint)
+{
+	int i, x = startPoint;
+
+	for (i = 0; i < SCALE_4; i++)
+	{
+		oldSin[i] = sin (((double) x * M_PI) / SCALE_2);
+		oldCos[i] = cos (((double) x * M_PI) / SCALE_2);
+		if (++x == SCALE_4)
+			x = 0;
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  C H E C K  V A L U E                                                                                              *
+ *  ====================                                                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+
+/**
+ *  \brief Compare one result with the old one, report the first few that differ.
+ *  \param name Call being checked.
+ *  \param number Radius passed in.
+ *  \param angle Angle passed in.
+ *  \param result Value returned.
+ *  \param expect Value the old code returned.
+ *  \result None.
+ */
+static void checkValue (char *name, int number, int angle, int result, int expect)
+{
+	if (result != expect)
+	{
+		if (++checkFailed <= 20)
+		{
+			printf ("%s (%d, %d) = %d, expected %d\n", name, number, angle, result, expect);
+		}
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  C H E C K  S T A R T  P O I N T                                                                                   *
+ *  ===============================                                                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+
+/**
+ *  \brief Check every angle, including wrapped ones, and every radius for one start point.
+ *  \param startPoint Angle the tables start at.
+ *  \result None.
+ */
+static void checkStartPoint (int startPoint)
+{
+	int angle, i, number[CHECK_COUNT], angles[CHECK_COUNT], sinOut[CHECK_COUNT], cosOut[CHECK_COUNT];
+
+	dialConfig.startPoint = startPoint;
+	dialInitOffscreen (&dialConfig);
+	fillOldTables (startPoint);
+
+	for (angle = -2 * SCALE_4; angle < 2 * SCALE_4; ++angle)
+	{
+		int wrapped = angle;
+
+		while (wrapped < 0) wrapped += SCALE_4;
+		wrapped %= SCALE_4;
+
+		for (i = 0; i < CHECK_COUNT; ++i)
+		{
+			int expectSin, expectCos;
+
+			number[i] = i - CHECK_RADIUS;
+			angles[i] = angle;
+			expectSin = (int)rint (number[i] * oldSin[wrapped]);
+			expectCos = (int)rint (number[i] * oldCos[wrapped]);
+			checkValue ("dialSin", number[i], angle, dialSin (number[i], angle), expectSin);
+			checkValue ("dialCos", number[i], angle, dialCos (number[i], angle), expectCos);
+		}
+
+		/*--------------------------------------------------------------------------------------------*
+         * The batch call must give the same as the single calls                                      *
+         *--------------------------------------------------------------------------------------------*/
+		dialSinCos (CHECK_COUNT, number, angles, sinOut, cosOut);
+		for (i = 0; i < CHECK_COUNT; ++i)
+		{
+			checkValue ("dialSinCos sin", number[i], angle, sinOut[i], (int)rint (number[i] * oldSin[wrapped]));
+			checkValue ("dialSinCos cos", number[i], angle, cosOut[i], (int)rint (number[i] * oldCos[wrapped]));
+		}
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  M A I N                                                                                                           *
+ *  =======                                                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+
+/**
+ *  \brief The program starts here.
+ *  \param argc Number of arguments.
+ *  \param argv The arguments, optional start points to check.
+ *  \result 0 if all the values match, 1 if any differ.
+ */
+int main (int argc, char *argv[])
+{
+	int i, checked = 0;
+
+	dialConfig.dialSize = 64;
+	dialConfig.dialWidth = dialConfig.dialHeight = 1;
+	dialConfig.colourDetails = colourNames;
+
+	if (argc > 1)
+	{
+		for (i = 1; i < argc; ++i, ++checked)
+			checkStartPoint (atoi (argv[i]) % SCALE_4);
+	}
+	else
+	{
+		for (i = 0; i < SCALE_4; i += SCALE_1 / 4, ++checked)
+			checkStartPoint (i);
+	}
+	printf ("%d start points, %lu mismatches\n", checked, checkFailed);
+	return checkFailed ? 1 : 0;
+}
@@ -28,18 +28,144 @@
 
 #include "dialsys.h"
 
+#define CONFIG_ARENA_SIZE	4096
+#define CONFIG_HASH_MIN		64
+
 typedef struct _configEntry
 {
 	char *configName;
 	char *configValue;
+	unsigned int nameHash;
+	int valueSize;
 	bool saveInFile;
 }
 CONFIG_ENTRY;
 
+/*----------------------------------------------------------------------------------------------------*
+ * Names, values and entries are carved out of big blocks and all freed together                      *
+ *----------------------------------------------------------------------------------------------------*/
+typedef struct _configArena
+{
+	struct _configArena *nextArena;
+	size_t arenaUsed;
+	size_t arenaSize;
+	char arenaData[];
+}
+CONFIG_ARENA;
+
 static void *configQueue = NULL;
+static CONFIG_ARENA *configArena = NULL;
+static CONFIG_ENTRY **configHash = NULL;
+static unsigned int hashSize = 0;
+static unsigned int hashCount = 0;
 static bool fileLoaded = false;
 int configSetValue (const char *configName, char *configValue);
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  C O N F I G  A L L O C                                                                                            *
+ *  ======================                                                                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Allocate some memory from the config arena.
+ *  \param size Number of bytes needed.
+ *  \result Pointer to the memory, NULL if none left.
+ */
+static void *configAlloc (size_t size)
+{
+	void *retnPtr;
+
+	size = (size + 7) & ~(size_t)7;
+	if (configArena == NULL || configArena -> arenaUsed + size > configArena -> arenaSize)
+	{
+		size_t newSize = size > CONFIG_ARENA_SIZE ? size : CONFIG_ARENA_SIZE;
+		CONFIG_ARENA *newArena;
+
+		if ((newArena = malloc (sizeof (CONFIG_ARENA) + newSize)) == NULL)
+			return NULL;
+
+		newArena -> nextArena = configArena;
+		newArena -> arenaUsed = 0;
+		newArena -> arenaSize = newSize;
+		configArena = newArena;
+	}
+	retnPtr = &configArena -> arenaData[configArena -> arenaUsed];
+	configArena -> arenaUsed += size;
+	return retnPtr;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  C O N F I G  H A S H  N A M E                                                                                     *
+ *  =============================                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Calculate the hash of a config name (FNV-1a).
+ *  \param configName Name to hash.
+ *  \result The hash value.
+ */
+static unsigned int configHashName (const char *configName)
+{
+	unsigned int hash = 2166136261u;
+
+	while (*configName)
+	{
+		hash ^= (unsigned char)*configName++;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  C O N F I G  H A S H  A D D                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Add an entry to the hash index, growing the index if it is getting full.
+ *  \param newEntry Entry to add.
+ *  \result True if added.
+ */
+static int configHashAdd (CONFIG_ENTRY *newEntry)
+{
+	unsigned int i;
+
+	if ((hashCount + 1) * 4 > hashSize * 3)
+	{
+		unsigned int newSize = hashSize ? hashSize << 1 : CONFIG_HASH_MIN;
+		CONFIG_ENTRY **newHash;
+
+		if ((newHash = calloc (newSize, sizeof (CONFIG_ENTRY *))) == NULL)
+			return 0;
+
+		for (i = 0; i < hashSize; ++i)
+		{
+			if (configHash[i] != NULL)
+			{
+				unsigned int j = configHash[i] -> nameHash & (newSize - 1);
+
+				while (newHash[j] != NULL)
+					j = (j + 1) & (newSize - 1);
+				newHash[j] = configHash[i];
+			}
+		}
+		free (configHash);
+		configHash = newHash;
+		hashSize = newSize;
+	}
+
+	i = newEntry -> nameHash & (hashSize - 1);
+	while (configHash[i] != NULL)
+		i = (i + 1) & (hashSize - 1);
+
+	configHash[i] = newEntry;
+	++hashCount;
+	return 1;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  C O N F I G  L O A D                                                                                              *
@@ -59,7 +185,7 @@ int configLoad (const char *configFile)
 
 	if (configQueue == NULL)
 	{
-		if ((configQueue = queueCreate ()) == NULL)
+		if ((configQueue = queueCreateArray ()) == NULL)
 			return 0;
 	}
 
@@ -152,13 +278,12 @@ int configLoad (const char *configFile)
  */
 int configSave (const char *configFile)
 {
-	int i = 0;
 	FILE *outFile = NULL;
 	CONFIG_ENTRY *foundEntry = NULL;
 
 	if (configQueue != NULL)
 	{
-		while ((foundEntry = queueRead (configQueue, i++)) != NULL)
+		for (foundEntry = queueReadFirst (configQueue); foundEntry != NULL; foundEntry = queueReadNext (configQueue))
 		{
 			if (foundEntry -> saveInFile)
 			{
@@ -200,14 +325,20 @@ void configFree ()
 	if (configQueue != NULL)
 	{
 		while ((foundEntry = queueGet (configQueue)) != NULL)
-		{
-			free (foundEntry -> configName);
-			free (foundEntry -> configValue);
-			free (foundEntry);
-		}
+			;
 		queueDelete (configQueue);
 		configQueue = NULL;
 	}
+	while (configArena != NULL)
+	{
+		CONFIG_ARENA *nextArena = configArena -> nextArena;
+
+		free (configArena);
+		configArena = nextArena;
+	}
+	free (configHash);
+	configHash = NULL;
+	hashSize = hashCount = 0;
 }
 
 /**********************************************************************************************************************
@@ -223,19 +354,20 @@ void configFree ()
  */
 static CONFIG_ENTRY *configFindEntry (const char *configName)
 {
-	int rec = 0;
-	CONFIG_ENTRY *foundEntry = NULL;
+	unsigned int nameHash, i;
 
-	if (configQueue != NULL)
+	if (hashCount == 0)
+		return NULL;
+
+	nameHash = configHashName (configName);
+	i = nameHash & (hashSize - 1);
+	while (configHash[i] != NULL)
 	{
-		while ((foundEntry = queueRead (configQueue, rec)) != NULL)
-		{
-			if (strcmp (configName, foundEntry -> configName) == 0)
-				break;
-			rec ++;
-		}
+		if (configHash[i] -> nameHash == nameHash && strcmp (configName, configHash[i] -> configName) == 0)
+			return configHash[i];
+		i = (i + 1) & (hashSize - 1);
 	}
-	return foundEntry;
+	return NULL;
 }
 
 /**********************************************************************************************************************
@@ -253,45 +385,55 @@ static CONFIG_ENTRY *configFindEntry (const char *configName)
 int configSetValue (const char *configName, char *configValue)
 {
 	CONFIG_ENTRY *newEntry = NULL;
+	int valueLen;
 
 	if (configQueue == NULL)
 	{
-		if ((configQueue = queueCreate ()) == NULL)
+		if ((configQueue = queueCreateArray ()) == NULL)
 			return 0;
 	}
 
+	valueLen = strlen (configValue) + 1;
 	if ((newEntry = configFindEntry (configName)) == NULL)
 	{
-		if ((newEntry = malloc (sizeof (CONFIG_ENTRY))) == NULL)
+		/*--------------------------------------------------------------------------------------------*
+         * New name, it is kept in the arena for as long as the config is loaded                      *
+         *--------------------------------------------------------------------------------------------*/
+		if ((newEntry = configAlloc (sizeof (CONFIG_ENTRY))) == NULL)
 			return 0;
 
-		if ((newEntry -> configName = malloc (strlen (configName) + 1)) == NULL)
-		{
-			free (newEntry);
+		if ((newEntry -> configName = configAlloc (strlen (configName) + 1)) == NULL)
 			return 0;
-		}
 		strcpy (newEntry -> configName, configName);
+		newEntry -> nameHash = configHashName (configName);
 
-		if ((newEntry -> configValue = malloc (strlen (configValue) + 1)) == NULL)
-		{
-			free (newEntry -> configName);
-			free (newEntry);
+		newEntry -> valueSize = (valueLen + 15) & ~15;
+		if ((newEntry -> configValue = configAlloc (newEntry -> valueSize)) == NULL)
 			return 0;
-		}
 		strcpy (newEntry -> configValue, configValue);
 		newEntry -> saveInFile = fileLoaded;
 
+		if (!configHashAdd (newEntry))
+			return 0;
 		queuePut (configQueue, newEntry);
 	}
 	else
 	{
-		char *tempPtr;
-		if ((tempPtr = malloc (strlen (configValue) + 1)) == NULL)
-			return 0;
+		/*--------------------------------------------------------------------------------------------*
+         * Reuse the value space unless the new value is too big for it                               *
+         *--------------------------------------------------------------------------------------------*/
+		if (valueLen > newEntry -> valueSize)
+		{
+			char *tempPtr;
+			int newSize = (valueLen + 15) & ~15;
+
+			if ((tempPtr = configAlloc (newSize)) == NULL)
+				return 0;
 
-		strcpy (tempPtr, configValue);
-		free (newEntry -> configValue);
-		newEntry -> configValue = tempPtr;
+			newEntry -> configValue = tempPtr;
+			newEntry -> valueSize = newSize;
+		}
+		strcpy (newEntry -> configValue, configValue);
 		newEntry -> saveInFile = fileLoaded;
 	}
 	return 1;
@@ -36,10 +36,72 @@ static cairo_t *saveCairo;
 static DIAL_CONFIG *dialConfig;
 
 /**********************************************************************************************************************
- * Use tables for the sin and cos calculation, it is faster.                                                          *
+ * Cache of the static part of each face (background, scale and markers), only redrawn when the settings change.      *
  **********************************************************************************************************************/
-static double sinTable[SCALE_4];
-static double cosTable[SCALE_4];
+typedef struct _faceCache
+{
+	cairo_surface_t *surface;
+	unsigned int generation;
+	int posX, posY, dialSize;
+	int markerType, markerStep, markerScale, dialGradient;
+	char faceKey[81];
+}
+FACE_CACHE;
+
+static FACE_CACHE faceCache[MAX_FACES];
+static unsigned int cacheGeneration = 1;
+static cairo_t *windowCairo;
+
+/**********************************************************************************************************************
+ * Cache of laid out text, most of the text (scale marks, captions) is the same every time it is drawn.               *
+ **********************************************************************************************************************/
+#define TEXT_CACHE_SIZE	256
+
+typedef struct _textCache
+{
+	char *text;
+	gint fontSize;
+	unsigned int generation;
+	PangoLayout *layout;
+}
+TEXT_CACHE;
+
+static TEXT_CACHE textCache[TEXT_CACHE_SIZE];
+static PangoContext *textContext;
+static PangoFontDescription *textFontDesc;
+static char *textFontName;
+static float textFontSize;
+
+/**********************************************************************************************************************
+ * Outline of each hand style, built once for a size and then only rotated into place each time the hand is drawn.    *
+ **********************************************************************************************************************/
+#define HAND_CACHE_SIZE	16
+#define HAND_MAX_POINTS	7
+#define HAND_POINT(n,a,c)	shape -> along[n] = (a); shape -> across[n] = (c)
+
+typedef struct _handShape
+{
+	int style, length, tail, dialSize;
+	unsigned int generation;
+	int numPoints, fill;
+	int along[HAND_MAX_POINTS];
+	int across[HAND_MAX_POINTS];
+}
+HAND_SHAPE;
+
+static HAND_SHAPE handCache[HAND_CACHE_SIZE];
+static int handCacheNext;
+
+/**********************************************************************************************************************
+ * Use fixed point tables for the sin and cos calculation, it is faster. The tables hold the value truncated to 39    *
+ * bits with the bottom bit set if anything was lost, so rounding gives exactly what rint would for any radius that   *
+ * fits on a screen.                                                                                                  *
+ **********************************************************************************************************************/
+#define TRIG_SHIFT		40
+#define TRIG_HALF		(1LL << (TRIG_SHIFT - 1))
+
+static long long sinTable[SCALE_4];
+static long long cosTable[SCALE_4];
 
 /**********************************************************************************************************************
  * Function prototypes.                                                                                               *
@@ -47,6 +109,42 @@ static double cosTable[SCALE_4];
 void dialWindowMask (void);
 void dialFillSinCosTables ();
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  D I A L  T R I G  W R A P                                                                                         *
+ *  =========================                                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Bring an angle into the range of the tables without looping.
+ *  \param angle Angle to wrap.
+ *  \result Angle from 0 to SCALE_4 - 1.
+ */
+static inline int dialTrigWrap (int angle)
+{
+	angle %= SCALE_4;
+	return angle + (SCALE_4 & -(angle < 0));
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  D I A L  T R I G  M U L                                                                                           *
+ *  =======================                                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Multiply by a table value and round to the nearest, ties to even as rint does.
+ *  \param number Radius to multiply.
+ *  \param value Fixed point value from the table.
+ *  \result Rounded result.
+ */
+static inline int dialTrigMul (int number, long long value)
+{
+	long long product = (long long)number * value;
+
+	return (int)((product + TRIG_HALF - 1 + ((product >> TRIG_SHIFT) & 1)) >> TRIG_SHIFT);
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  D I A L  I N I T                                                                                                  *
@@ -60,10 +158,7 @@ void dialFillSinCosTables ();
  */
 GtkWidget *dialInit (DIAL_CONFIG *dialConfigIn)
 {
-	dialConfig = dialConfigIn;
-
-	dialFillSinCosTables ();
-	dialMaxColours = dialCreateColours();
+	dialInitOffscreen (dialConfigIn);
 	dialConfig -> drawingArea = gtk_drawing_area_new ();
 	gtk_widget_set_size_request (dialConfig -> drawingArea, dialConfig -> dialWidth * dialConfig -> dialSize,
 			dialConfig -> dialHeight * dialConfig -> dialSize);
@@ -72,6 +167,25 @@ GtkWidget *dialInit (DIAL_CONFIG *dialConfigIn)
 	return dialConfig -> drawingArea;
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  D I A L  I N I T  O F F S C R E E N                                                                               *
+ *  ===================================                                                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Set up the dial display system without a window, for drawing on to any cairo surface.
+ *  \param dialConfigIn Current dial config.
+ *  \result None.
+ */
+void dialInitOffscreen (DIAL_CONFIG *dialConfigIn)
+{
+	dialConfig = dialConfigIn;
+
+	dialFillSinCosTables ();
+	dialMaxColours = dialCreateColours();
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  D I A L  C H E C K  V E R S I O N                                                                                 *
@@ -169,9 +283,135 @@ void dialDrawStart (cairo_t *cr, int posX, int posY)
  */
 void dialDrawFinish ()
 {
+	if (windowCairo)
+		dialDrawCacheDone ();
+
 	cairo_restore (saveCairo);
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  D I A L  D R A W  S T A R T  C A C H E D                                                                          *
+ *  ========================================                                                                          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Start the drawing of a dial, painting the cached face background if it is still valid.
+ *  \param cr Cairo context saved for later.
+ *  \param posX X position of the gauge.
+ *  \param posY Y position of the gauge.
+ *  \param face Which face, -1 to draw without the cache.
+ *  \param faceKey Application settings that change the background.
+ *  \result True if the background was painted, false if it should be drawn followed by dialDrawCacheDone.
+ */
+bool dialDrawStartCached (cairo_t *cr, int posX, int posY, int face, char *faceKey)
+{
+	FACE_CACHE *cache;
+	cairo_t *offCairo;
+
+	dialDrawStart (cr, posX, posY);
+	if (face < 0 || face >= MAX_FACES)
+		return false;
+
+	cache = &faceCache[face];
+	if (cache -> surface && cache -> generation == cacheGeneration &&
+			cache -> posX == posX && cache -> posY == posY &&
+			cache -> dialSize == dialConfig -> dialSize &&
+			cache -> markerType == dialConfig -> markerType &&
+			cache -> markerStep == dialConfig -> markerStep &&
+			cache -> markerScale == dialConfig -> markerScale &&
+			cache -> dialGradient == dialConfig -> dialGradient &&
+			strcmp (cache -> faceKey, faceKey) == 0)
+	{
+		cairo_set_source_surface (saveCairo, cache -> surface, posX, posY);
+		cairo_paint (saveCairo);
+		return true;
+	}
+
+	/*------------------------------------------------------------------------------------------------*
+     * Out of date so redirect the drawing to an off screen surface the size of the face              *
+     *------------------------------------------------------------------------------------------------*/
+	if (cache -> surface && cache -> dialSize != dialConfig -> dialSize)
+	{
+		cairo_surface_destroy (cache -> surface);
+		cache -> surface = NULL;
+	}
+	if (cache -> surface == NULL)
+	{
+		cache -> surface = cairo_surface_create_similar (cairo_get_target (cr), CAIRO_CONTENT_COLOR_ALPHA,
+				dialConfig -> dialSize, dialConfig -> dialSize);
+		if (cairo_surface_status (cache -> surface) != CAIRO_STATUS_SUCCESS)
+		{
+			cairo_surface_destroy (cache -> surface);
+			cache -> surface = NULL;
+			return false;
+		}
+	}
+	offCairo = cairo_create (cache -> surface);
+	cairo_set_operator (offCairo, CAIRO_OPERATOR_CLEAR);
+	cairo_paint (offCairo);
+	cairo_set_operator (offCairo, CAIRO_OPERATOR_OVER);
+	cairo_translate (offCairo, -posX, -posY);
+	cairo_set_line_cap (offCairo, CAIRO_LINE_CAP_BUTT);
+	cairo_set_line_join (offCairo, CAIRO_LINE_JOIN_MITER);
+
+	cache -> generation = cacheGeneration;
+	cache -> posX = posX;
+	cache -> posY = posY;
+	cache -> dialSize = dialConfig -> dialSize;
+	cache -> markerType = dialConfig -> markerType;
+	cache -> markerStep = dialConfig -> markerStep;
+	cache -> markerScale = dialConfig -> markerScale;
+	cache -> dialGradient = dialConfig -> dialGradient;
+	strncpy (cache -> faceKey, faceKey, 80);
+	cache -> faceKey[80] = 0;
+
+	windowCairo = saveCairo;
+	saveCairo = offCairo;
+	return false;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  D I A L  D R A W  C A C H E  D O N E                                                                              *
+ *  ====================================                                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief The face background has been drawn off screen, so put it on the window.
+ *  \result None.
+ */
+void dialDrawCacheDone (void)
+{
+	if (windowCairo)
+	{
+		cairo_surface_t *surface = cairo_get_target (saveCairo);
+
+		cairo_destroy (saveCairo);
+		cairo_surface_flush (surface);
+		saveCairo = windowCairo;
+		windowCairo = NULL;
+
+		cairo_set_source_surface (saveCairo, surface, savePosX, savePosY);
+		cairo_paint (saveCairo);
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  D I A L  C A C H E  I N V A L I D A T E                                                                           *
+ *  =======================================                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Force all the face backgrounds to be redrawn.
+ *  \result None.
+ */
+void dialCacheInvalidate (void)
+{
+	++cacheGeneration;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  D I A L  C O L O U R                                                                                              *
@@ -615,6 +855,119 @@ void dialDrawSquareX (int posX, int posY, int size, int colFill, int colOut)
 	}
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  D I A L  H A N D  S H A P E                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Find or build the outline of a hand, each point is a distance along and across the hand.
+ *  \param handStyle Style structure of the hand.
+ *  \result Pointer to the cached outline.
+ */
+static HAND_SHAPE *dialHandShape (HAND_STYLE *handStyle)
+{
+	int i, dialSize = dialConfig -> dialSize;
+	int size = handStyle -> length, style = handStyle -> style, tail = handStyle -> tail;
+	int back, front, width;
+	HAND_SHAPE *shape;
+
+	for (i = 0; i < HAND_CACHE_SIZE; ++i)
+	{
+		shape = &handCache[i];
+		if (shape -> generation == cacheGeneration && shape -> dialSize == dialSize &&
+				shape -> style == style && shape -> length == size && shape -> tail == tail)
+		{
+			return shape;
+		}
+	}
+
+	shape = &handCache[handCacheNext];
+	handCacheNext = (handCacheNext + 1) % HAND_CACHE_SIZE;
+
+	shape -> style = style;
+	shape -> length = size;
+	shape -> tail = tail;
+	shape -> dialSize = dialSize;
+	shape -> generation = cacheGeneration;
+	shape -> fill = 1;
+
+	back = -((dialSize * tail) >> 6);
+	front = (dialSize * size) >> 6;
+	width = dialSize >> 6;
+
+	switch (style)
+	{
+	case 0:
+		/* Original double triangle */
+		HAND_POINT (0, back, 0);
+		HAND_POINT (1, 0, width);
+		HAND_POINT (2, front, 0);
+		HAND_POINT (3, 0, -width);
+		shape -> numPoints = 4;
+		break;
+
+	case 1:
+		/* Single triangle */
+		HAND_POINT (0, back, width);
+		HAND_POINT (1, back, -width);
+		HAND_POINT (2, front, 0);
+		shape -> numPoints = 3;
+		break;
+
+	case 2:
+		/* Rectangle */
+		HAND_POINT (0, back, width);
+		HAND_POINT (1, back, -width);
+		HAND_POINT (2, front, -width);
+		HAND_POINT (3, front, width);
+		shape -> numPoints = 4;
+		break;
+
+	case 3:
+		/*Rectangle with pointer */
+		HAND_POINT (0, back, width);
+		HAND_POINT (1, back, -width);
+		HAND_POINT (2, (dialSize * (size * 15)) >> 10, -width);
+		HAND_POINT (3, front, 0);
+		HAND_POINT (4, (dialSize * (size * 15)) >> 10, width);
+		shape -> numPoints = 5;
+		break;
+
+	case 4:
+		/*Rectangle with arrow */
+		HAND_POINT (0, back, width);
+		HAND_POINT (1, back, -width);
+		HAND_POINT (2, (dialSize * (size * 12)) >> 10, -width);
+		HAND_POINT (3, (dialSize * (size * 12)) >> 10, -(dialSize / 30));
+		HAND_POINT (4, front, 0);
+		HAND_POINT (5, (dialSize * (size * 12)) >> 10, dialSize / 30);
+		HAND_POINT (6, (dialSize * (size * 12)) >> 10, width);
+		shape -> numPoints = 7;
+		break;
+
+	case 5:
+		/* Single triangle */
+		HAND_POINT (0, back, dialSize / 40);
+		HAND_POINT (1, back, -(dialSize / 40));
+		HAND_POINT (2, front, 0);
+		shape -> numPoints = 3;
+		break;
+
+	case 9:
+	default:
+		/* Simple line */
+		HAND_POINT (0, back, 0);
+		HAND_POINT (1, front, 0);
+		shape -> numPoints = 2;
+		shape -> fill = 0;
+		break;
+	}
+
+	return shape;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  D I A L  D R A W  H A N D                                                                                         *
@@ -648,9 +1001,10 @@ void dialDrawHand (int angle, HAND_STYLE *handStyle)
  */
 void dialDrawHandX (int posX, int posY, int angle, HAND_STYLE *handStyle)
 {
-	int points[20], i, j, numPoints, fill = 0;
-	int size = handStyle -> length, style = handStyle -> style, tail = handStyle -> tail;
+	int points[HAND_MAX_POINTS * 2], i, j, numPoints, fill;
 	int colFill = handStyle -> fill, colOut = handStyle -> line;
+	HAND_SHAPE *shape;
+	long long sinA, cosA;
 
 	if (handStyle -> gauge)
 	{
@@ -663,110 +1017,16 @@ void dialDrawHandX (int posX, int posY, int angle, HAND_STYLE *handStyle)
 		while (angle >= SCALE_4) angle -= SCALE_4;
 	}
 
-	switch (style)
+	shape = dialHandShape (handStyle);
+	sinA = sinTable[angle];
+	cosA = cosTable[angle];
+	for (j = 0; j < shape -> numPoints; ++j)
 	{
-	case 0:
-		/* Original double triangle */
-		points[0] = posX + dialSin ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2);
-		points[1] = posY - dialCos ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2);
-		points[2] = posX + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[3] = posY - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[4] = posX + dialSin ((dialConfig -> dialSize * size) >> 6, angle);
-		points[5] = posY - dialCos ((dialConfig -> dialSize * size) >> 6, angle);
-		points[6] = posX + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[7] = posY - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		numPoints = 4;
-		fill = 1;
-		break;
-
-	case 1:
-		/* Single triangle */
-		points[0] = posX + dialSin ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2)
-					+ dialSin (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[1] = posY - dialCos ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2)
-					- dialCos (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[2] = posX + dialSin ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2)
-					+ dialSin (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[3] = posY - dialCos ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2)
-					- dialCos (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[4] = posX + dialSin ((dialConfig -> dialSize * size) >> 6, angle);
-		points[5] = posY - dialCos ((dialConfig -> dialSize * size) >> 6, angle);
-		numPoints = 3;
-		fill = 1;
-		break;
-
-	case 2:
-		/* Rectangle */
-		points[0] = posX + dialSin ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[1] = posY - dialCos ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[2] = posX + dialSin ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[3] = posY - dialCos ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[4] = posX + dialSin ((dialConfig -> dialSize * size) >> 6, angle) + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[5] = posY - dialCos ((dialConfig -> dialSize * size) >> 6, angle) - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[6] = posX + dialSin ((dialConfig -> dialSize * size) >> 6, angle) + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[7] = posY - dialCos ((dialConfig -> dialSize * size) >> 6, angle) - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		numPoints = 4;
-		fill = 1;
-		break;
-
-	case 3:
-		/*Rectangle with pointer */
-		points[0] = posX + dialSin ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[1] = posY - dialCos ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[2] = posX + dialSin ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[3] = posY - dialCos ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[4] = posX + dialSin ((dialConfig -> dialSize * (size * 15)) >> 10, angle) + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[5] = posY - dialCos ((dialConfig -> dialSize * (size * 15)) >> 10, angle) - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[6] = posX + dialSin ((dialConfig -> dialSize * size) >> 6, angle);
-		points[7] = posY - dialCos ((dialConfig -> dialSize * size) >> 6, angle);
-		points[8] = posX + dialSin ((dialConfig -> dialSize * (size * 15)) >> 10, angle) + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[9] = posY - dialCos ((dialConfig -> dialSize * (size * 15)) >> 10, angle) - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		numPoints = 5;
-		fill = 1;
-		break;
-
-	case 4:
-		/*Rectangle with arrow */
-		points[0] = posX + dialSin ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[1] = posY - dialCos ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[2] = posX + dialSin ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[3] = posY - dialCos ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[4] = posX + dialSin ((dialConfig -> dialSize * (size * 12)) >> 10, angle) + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[5] = posY - dialCos ((dialConfig -> dialSize * (size * 12)) >> 10, angle) - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_3);
-		points[6] = posX + dialSin ((dialConfig -> dialSize * (size * 12)) >> 10, angle) + dialSin (dialConfig -> dialSize / 30, angle + SCALE_3);
-		points[7] = posY - dialCos ((dialConfig -> dialSize * (size * 12)) >> 10, angle) - dialCos (dialConfig -> dialSize / 30, angle + SCALE_3);
-		points[8] = posX + dialSin ((dialConfig -> dialSize * size) >> 6, angle);
-		points[9] = posY - dialCos ((dialConfig -> dialSize * size) >> 6, angle);
-		points[10] = posX + dialSin ((dialConfig -> dialSize * (size * 12)) >> 10, angle) + dialSin (dialConfig -> dialSize / 30, angle + SCALE_1);
-		points[11] = posY - dialCos ((dialConfig -> dialSize * (size * 12)) >> 10, angle) - dialCos (dialConfig -> dialSize / 30, angle + SCALE_1);
-		points[12] = posX + dialSin ((dialConfig -> dialSize * (size * 12)) >> 10, angle) + dialSin (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		points[13] = posY - dialCos ((dialConfig -> dialSize * (size * 12)) >> 10, angle) - dialCos (dialConfig -> dialSize >> 6, angle + SCALE_1);
-		numPoints = 7;
-		fill = 1;
-		break;
-
-	case 5:
-		/* Single triangle */
-		points[0] = posX + dialSin ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) + dialSin (dialConfig -> dialSize / 40, angle + SCALE_1);
-		points[1] = posY - dialCos ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) - dialCos (dialConfig -> dialSize / 40, angle + SCALE_1);
-		points[2] = posX + dialSin ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) + dialSin (dialConfig -> dialSize / 40, angle + SCALE_3);
-		points[3] = posY - dialCos ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2) - dialCos (dialConfig -> dialSize / 40, angle + SCALE_3);
-		points[4] = posX + dialSin ((dialConfig -> dialSize * size) >> 6, angle);
-		points[5] = posY - dialCos ((dialConfig -> dialSize * size) >> 6, angle);
-		numPoints = 3;
-		fill = 1;
-		break;
-
-	case 9:
-	default:
-		/* Simple line */
-		points[0] = posX + dialSin ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2);
-		points[1] = posY - dialCos ((dialConfig -> dialSize * tail) >> 6, angle + SCALE_2);
-		points[2] = posX + dialSin ((dialConfig -> dialSize * size) >> 6, angle);
-		points[3] = posY - dialCos ((dialConfig -> dialSize * size) >> 6, angle);
-		numPoints = 2;
-		break;
+		points[j << 1] = posX + dialTrigMul (shape -> along[j], sinA) + dialTrigMul (shape -> across[j], cosA);
+		points[(j << 1) + 1] = posY - dialTrigMul (shape -> along[j], cosA) + dialTrigMul (shape -> across[j], sinA);
 	}
+	numPoints = shape -> numPoints;
+	fill = shape -> fill;
 
 	cairo_set_line_width (saveCairo, 1.0f + ((float)dialConfig -> dialSize / 256.0f));
 	if (!handStyle -> fillIn)
@@ -842,14 +1102,19 @@ void dialDrawMarkX (int posX, int posY, int angle, int size, int colFill, int co
 		case 1:
 			/* Triangle markers */
 			{
-				int points[6], i;
+				int points[6], radius[3], angles[3], sinOut[3], cosOut[3], i;
 				cairo_set_line_width (saveCairo, 1.0f + ((float)dialConfig -> dialSize / 512.0f));
-				points[0] = posX + dialSin ((dialConfig -> dialSize * size) >> 6, angle + 5);
-				points[1] = posY - dialCos ((dialConfig -> dialSize * size) >> 6, angle + 5);
-				points[2] = posX + dialSin ((dialConfig -> dialSize * (size - 3)) >> 6, angle);
-				points[3] = posY - dialCos ((dialConfig -> dialSize * (size - 3)) >> 6, angle);
-				points[4] = posX + dialSin ((dialConfig -> dialSize * size) >> 6, angle - 5);
-				points[5] = posY - dialCos ((dialConfig -> dialSize * size) >> 6, angle - 5);
+				radius[0] = radius[2] = (dialConfig -> dialSize * size) >> 6;
+				radius[1] = (dialConfig -> dialSize * (size - 3)) >> 6;
+				angles[0] = angle + 5;
+				angles[1] = angle;
+				angles[2] = angle - 5;
+				dialSinCos (3, radius, angles, sinOut, cosOut);
+				for (i = 0; i < 3; i++)
+				{
+					points[i << 1] = posX + sinOut[i];
+					points[(i << 1) + 1] = posY - cosOut[i];
+				}
 				for (i = 0; i < 2; i++)
 				{
 					dialSetColour (i == 0 ? colFill : colOut);
@@ -975,6 +1240,64 @@ void dialDrawTextS (int posn, char *string1, int colour, int scale)
 	}
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  D I A L  T E X T  L A Y O U T                                                                                     *
+ *  =============================                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Find the text in the cache or lay it out and add it, must be called after the font description is read.
+ *  \param string1 Text to display.
+ *  \param fontSize Size of the font in pango units.
+ *  \result The laid out text, NULL if out of memory.
+ */
+static PangoLayout *dialTextLayout (char *string1, gint fontSize)
+{
+	unsigned int hash = (unsigned int)fontSize;
+	TEXT_CACHE *entry;
+	char *textPtr;
+
+	/*------------------------------------------------------------------------------------------------*
+     * All the layouts share one context, it is updated to match the surface being drawn on           *
+     *------------------------------------------------------------------------------------------------*/
+	if (textContext == NULL)
+	{
+		if ((textContext = pango_cairo_create_context (saveCairo)) == NULL)
+			return NULL;
+	}
+	pango_cairo_update_context (saveCairo, textContext);
+
+	for (textPtr = string1; *textPtr; ++textPtr)
+		hash = (hash * 31) + (unsigned char)*textPtr;
+
+	entry = &textCache[hash & (TEXT_CACHE_SIZE - 1)];
+	if (entry -> layout != NULL && entry -> generation == cacheGeneration && entry -> fontSize == fontSize &&
+			strcmp (entry -> text, string1) == 0)
+	{
+		return entry -> layout;
+	}
+
+	if (entry -> layout != NULL)
+	{
+		g_object_unref (entry -> layout);
+		free (entry -> text);
+		entry -> layout = NULL;
+	}
+	if ((entry -> text = strdup (string1)) == NULL)
+		return NULL;
+
+	entry -> layout = pango_layout_new (textContext);
+	entry -> fontSize = fontSize;
+	entry -> generation = cacheGeneration;
+
+	pango_font_description_set_size (textFontDesc, fontSize);
+	pango_layout_set_font_description (entry -> layout, textFontDesc);
+	pango_layout_set_alignment (entry -> layout, PANGO_ALIGN_CENTER);
+	pango_layout_set_text (entry -> layout, string1, -1);
+	return entry -> layout;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  D I A L  D R A W  T E X T  X                                                                                      *
@@ -996,8 +1319,22 @@ void dialDrawTextX (int posX, int posY, char *string1, int colour, int scale)
 	{
 		float fontSize = 0;
 		gint posW, posH;
+		PangoLayout *layout;
+
+		/*--------------------------------------------------------------------------------------------*
+         * Only read the font description when the font is changed                                    *
+         *--------------------------------------------------------------------------------------------*/
+		if (textFontName == NULL || strcmp (textFontName, dialConfig -> fontName) != 0)
+		{
+			if (textFontDesc != NULL)
+				pango_font_description_free (textFontDesc);
+			free (textFontName);
 
-		if ((fontSize = dialGetFontSize (dialConfig -> fontName)) == 0)
+			textFontDesc = pango_font_description_from_string (dialConfig -> fontName);
+			textFontSize = dialGetFontSize (dialConfig -> fontName);
+			textFontName = strdup (dialConfig -> fontName);
+		}
+		if ((fontSize = textFontSize) == 0)
 		{
 			fontSize = (dialConfig -> dialSize >> 6) << 2;
 			if (fontSize < 6) fontSize = 6;
@@ -1006,22 +1343,14 @@ void dialDrawTextX (int posX, int posY, char *string1, int colour, int scale)
 		{
 			fontSize = (fontSize * scale) / 10;
 		}
-		PangoLayout *layout = pango_cairo_create_layout (saveCairo);
-		PangoFontDescription *fontDesc = pango_font_description_from_string (dialConfig -> fontName);
-
-		pango_font_description_set_size (fontDesc, (gint)(fontSize * (float)PANGO_SCALE));
-		pango_layout_set_font_description (layout, fontDesc);
-		pango_layout_set_alignment (layout, PANGO_ALIGN_CENTER);
+		if ((layout = dialTextLayout (string1, (gint)(fontSize * (float)PANGO_SCALE))) == NULL)
+			return;
 
 		dialSetColour (colour);
-		pango_layout_set_text (layout, string1, -1);
 		pango_layout_get_pixel_size (layout, &posW, &posH);
 
 		cairo_move_to (saveCairo, posX - (posW >> 1), posY - (posH >> 1));
 		pango_cairo_show_layout (saveCairo, layout);
-
-		pango_font_description_free (fontDesc);
-		g_object_unref (layout);
 	}
 }
 
@@ -1062,6 +1391,7 @@ dialFontCallback (guint data)
 			selectedFont = gtk_font_chooser_get_font ((GtkFontChooser *)dialog);
 			strcpy (dialConfig -> fontName, selectedFont);
 			g_free (selectedFont);
+			dialCacheInvalidate ();
 			if (dialConfig -> UpdateFunc) dialConfig -> UpdateFunc();
 			break;
 		}
@@ -1230,6 +1560,7 @@ void dialColourCallback (guint data)
 				}
 				dialConfig -> colourDetails[i].dialColour = setColour;
 			}
+			dialCacheInvalidate ();
 			if (dialConfig -> UpdateFunc) dialConfig -> UpdateFunc();
 			break;
 		}
@@ -1268,6 +1599,28 @@ dialCreateColours ()
 	return i;
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  D I A L  T R I G  F I X E D                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Convert a sin or cos value to fixed point for the tables.
+ *  \param value Value to convert.
+ *  \result Value truncated, with the bottom bit set if it was not exact.
+ */
+static long long dialTrigFixed (double value)
+{
+	double scaled = ldexp (value, TRIG_SHIFT - 1);
+	long long fixed = (long long)scaled;
+
+	if (scaled != (double)fixed)
+		return (fixed * 2) + (value < 0 ? -1 : 1);
+
+	return fixed * 2;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  D I A L  F I L L  S I N  C O S  T A B L E S                                                                       *
@@ -1284,8 +1637,8 @@ void dialFillSinCosTables ()
 
 	for (i = 0; i < SCALE_4; i++)
 	{
-		sinTable[i] = sin (((double) x * M_PI) / SCALE_2);
-		cosTable[i] = cos (((double) x * M_PI) / SCALE_2);
+		sinTable[i] = dialTrigFixed (sin (((double) x * M_PI) / SCALE_2));
+		cosTable[i] = dialTrigFixed (cos (((double) x * M_PI) / SCALE_2));
 		if (++x == SCALE_4)
 			x = 0;
 	}
@@ -1305,10 +1658,7 @@ void dialFillSinCosTables ()
  */
 int dialSin (int number, int angle)
 {
-	while (angle < 0) angle += SCALE_4;
-	angle %= SCALE_4;
-
-	return (int)rint(number * sinTable[angle]);
+	return dialTrigMul (number, sinTable[dialTrigWrap (angle)]);
 }
 
 /**********************************************************************************************************************
@@ -1325,10 +1675,34 @@ int dialSin (int number, int angle)
  */
 int dialCos (int number, int angle)
 {
-	while (angle < 0) angle += SCALE_4;
-	angle %= SCALE_4;
+	return dialTrigMul (number, cosTable[dialTrigWrap (angle)]);
+}
 
-	return (int)rint(number * cosTable[angle]);
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  D I A L  S I N  C O S                                                                                             *
+ *  =====================                                                                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Get the sin and cos values for a batch of points, same results as dialSin and dialCos.
+ *  \param count Number of points.
+ *  \param number Radius of each point.
+ *  \param angle Angle of each point.
+ *  \param sinOut Returns the sin of each point.
+ *  \param cosOut Returns the cos of each point.
+ *  \result None.
+ */
+void dialSinCos (int count, int *number, int *angle, int *sinOut, int *cosOut)
+{
+	int i, wrapped;
+
+	for (i = 0; i < count; ++i)
+	{
+		wrapped = dialTrigWrap (angle[i]);
+		sinOut[i] = dialTrigMul (number[i], sinTable[wrapped]);
+		cosOut[i] = dialTrigMul (number[i], cosTable[wrapped]);
+	}
 }
 
 /**********************************************************************************************************************
@@ -1397,6 +1771,7 @@ dialZoomCallback (guint data)
 	}
 	dialFixFaceSize ();
 	dialWindowMask();
+	dialCacheInvalidate ();
 	gtk_widget_set_size_request (dialConfig -> drawingArea, dialConfig -> dialWidth * dialConfig -> dialSize, dialConfig -> dialHeight * dialConfig -> dialSize);
 
 	if (dialConfig -> UpdateFunc) dialConfig -> UpdateFunc();
@@ -1417,6 +1792,7 @@ void
 dialMarkerCallback (guint data)
 {
 	dialConfig -> markerType = data;
+	dialCacheInvalidate ();
 	if (dialConfig -> UpdateFunc) dialConfig -> UpdateFunc();
 }
 
@@ -1435,6 +1811,7 @@ void
 dialStepCallback (guint data)
 {
 	dialConfig -> markerStep = data;
+	dialCacheInvalidate ();
 	if (dialConfig -> UpdateFunc) dialConfig -> UpdateFunc();
 }
 
@@ -1473,6 +1850,7 @@ dialAddDelCallback (guint data)
 	}
 
 	dialWindowMask();
+	dialCacheInvalidate ();
 	gtk_widget_set_size_request (dialConfig -> drawingArea, dialConfig -> dialWidth * dialConfig -> dialSize, dialConfig -> dialHeight * dialConfig -> dialSize);
 
 	if (dialConfig -> UpdateFunc) dialConfig -> UpdateFunc();
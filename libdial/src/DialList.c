@@ -41,9 +41,42 @@ typedef struct _queueItem
 	void *myNextPtr;
 	void *myPrevPtr;
 	void *myData;
+	void *mySkipPtr[];
 }
 QUEUE_ITEM;
 
+/*----------------------------------------------------------------------------------------------------*
+ *                                                                                                    *
+ * Items are handed out from blocks owned by the queue, freed items are kept for reuse                *
+ *                                                                                                    *
+ *----------------------------------------------------------------------------------------------------*/
+typedef struct _queueSlab
+{
+	struct _queueSlab *nextSlab;
+}
+QUEUE_SLAB;
+
+#define QUEUE_SLAB_ITEMS	64
+#define QUEUE_SKIP_LEVELS	8
+
+/*----------------------------------------------------------------------------------------------------*
+ *                                                                                                    *
+ * Ring used by a single producer single consumer queue, the indexes are on separate cache lines      *
+ *                                                                                                    *
+ *----------------------------------------------------------------------------------------------------*/
+#define QUEUE_CACHE_LINE	64
+
+typedef struct _queueRing
+{
+	unsigned long readIndex;
+	char readPad[QUEUE_CACHE_LINE - sizeof (unsigned long)];
+	unsigned long writeIndex;
+	char writePad[QUEUE_CACHE_LINE - sizeof (unsigned long)];
+	unsigned long ringMask;
+	void *ringData[];
+}
+QUEUE_RING;
+
 /*----------------------------------------------------------------------------------------------------*
  *                                                                                                    *
  * Structure to hold the queue header                                                                 *
@@ -53,9 +86,22 @@ typedef struct _queueHeader
 {
 	QUEUE_ITEM *firstInQueue;
 	QUEUE_ITEM *lastInQueue;
-	QUEUE_ITEM *currentItem;
+	QUEUE_ITEM *readItem;		/* Where queueRead got to */
+	unsigned long readIndex;
+	QUEUE_ITEM *walkItem;		/* Where queueReadFirst and queueReadNext got to */
+	unsigned long walkIndex;
 	unsigned long itemCount;
 	unsigned long freeData;
+	void **dataArray;
+	unsigned long arraySize;
+	unsigned long arrayHead;
+	QUEUE_ITEM *freeItems;
+	QUEUE_SLAB *slabList;
+	size_t itemSize;
+	QUEUE_ITEM *skipHead[QUEUE_SKIP_LEVELS - 1];
+	int skipLevel;
+	unsigned int skipRandom;
+	QUEUE_RING *spscRing;
 
 #ifdef MULTI_THREAD
 #ifdef WIN32
@@ -71,6 +117,12 @@ typedef struct _queueHeader
 }
 QUEUE_HEADER;
 
+/*----------------------------------------------------------------------------------------------------*
+ * An array queue is a ring buffer, the size is always a power of two                                 *
+ *----------------------------------------------------------------------------------------------------*/
+#define ARRAY_START_SIZE	16
+#define ARRAY_ITEM(q,i)		(q) -> dataArray[((q) -> arrayHead + (i)) & ((q) -> arraySize - 1)]
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  Q U E U E  L O C K                                                                                                *
@@ -142,9 +194,19 @@ void *queueCreate ()
 
 	newQueue -> firstInQueue = NULL;
 	newQueue -> lastInQueue = NULL;
-	newQueue -> currentItem = NULL;
+	newQueue -> readItem = newQueue -> walkItem = NULL;
+	newQueue -> readIndex = newQueue -> walkIndex = 0;
 	newQueue -> itemCount = 0;
 	newQueue -> freeData = 0;
+	newQueue -> dataArray = NULL;
+	newQueue -> arraySize = 0;
+	newQueue -> arrayHead = 0;
+	newQueue -> freeItems = NULL;
+	newQueue -> slabList = NULL;
+	newQueue -> itemSize = sizeof (QUEUE_ITEM);
+	newQueue -> skipLevel = 0;
+	newQueue -> skipRandom = 2463534242u;
+	newQueue -> spscRing = NULL;
 
 #ifdef MULTI_THREAD
 #ifdef WIN32
@@ -160,6 +222,299 @@ void *queueCreate ()
 	return newQueue;
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Q U E U E  C R E A T E  S O R T E D                                                                               *
+ *  ===================================                                                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Create a queue kept as a skip list, so queuePutSort does not have to compare every item.
+ *  \result A void pointer (handle) to the queue.
+ */
+void *queueCreateSorted ()
+{
+	QUEUE_HEADER *newQueue;
+	int i;
+
+	if ((newQueue = queueCreate ()) == NULL)
+		return NULL;
+
+	newQueue -> itemSize = sizeof (QUEUE_ITEM) + ((QUEUE_SKIP_LEVELS - 1) * sizeof (void *));
+	newQueue -> skipLevel = 1;
+	for (i = 0; i < QUEUE_SKIP_LEVELS - 1; ++i)
+		newQueue -> skipHead[i] = NULL;
+
+	return newQueue;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Q U E U E  C R E A T E  S P S C                                                                                   *
+ *  ===============================                                                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Create a fixed size queue for passing items from one thread to another without locking. Only one thread
+ *  may add items (queuePut, queueTryPut) and only one thread may take them off (queueGet, queueRead).
+ *  \param queueSize Number of items the queue can hold, rounded up to a power of two.
+ *  \result A void pointer (handle) to the queue.
+ */
+void *queueCreateSPSC (unsigned long queueSize)
+{
+	QUEUE_HEADER *newQueue;
+	unsigned long ringSize = 2;
+
+	while (ringSize < queueSize)
+		ringSize <<= 1;
+
+	if ((newQueue = queueCreate ()) == NULL)
+		return NULL;
+
+	if ((newQueue -> spscRing = malloc (sizeof (QUEUE_RING) + (ringSize * sizeof (void *)))) == NULL)
+	{
+		queueDelete (newQueue);
+		return NULL;
+	}
+	newQueue -> spscRing -> readIndex = 0;
+	newQueue -> spscRing -> writeIndex = 0;
+	newQueue -> spscRing -> ringMask = ringSize - 1;
+	return newQueue;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Q U E U E  R I N G  P U T                                                                                         *
+ *  =========================                                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Add an item to a single producer single consumer queue, only called by the producer.
+ *  \param myRing Ring to add to.
+ *  \param putData Thing to put on the queue.
+ *  \result True if added, false if the queue is full.
+ */
+static int queueRingPut (QUEUE_RING *myRing, void *putData)
+{
+	unsigned long writeIndex = __atomic_load_n (&myRing -> writeIndex, __ATOMIC_RELAXED);
+
+	if (writeIndex - __atomic_load_n (&myRing -> readIndex, __ATOMIC_ACQUIRE) > myRing -> ringMask)
+		return 0;
+
+	myRing -> ringData[writeIndex & myRing -> ringMask] = putData;
+	__atomic_store_n (&myRing -> writeIndex, writeIndex + 1, __ATOMIC_RELEASE);
+	return 1;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Q U E U E  R I N G  R E A D                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read an item from a single producer single consumer queue, only called by the consumer.
+ *  \param myRing Ring to read from.
+ *  \param item Item number to read.
+ *  \param remove Take the item off the queue if it is the first.
+ *  \result The item, NULL if there are not that many items.
+ */
+static void *queueRingRead (QUEUE_RING *myRing, unsigned long item, int remove)
+{
+	unsigned long readIndex = __atomic_load_n (&myRing -> readIndex, __ATOMIC_RELAXED);
+	void *retn;
+
+	if (__atomic_load_n (&myRing -> writeIndex, __ATOMIC_ACQUIRE) - readIndex <= item)
+		return NULL;
+
+	retn = myRing -> ringData[(readIndex + item) & myRing -> ringMask];
+	if (remove && item == 0)
+		__atomic_store_n (&myRing -> readIndex, readIndex + 1, __ATOMIC_RELEASE);
+	return retn;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Q U E U E  I T E M  A L L O C                                                                                     *
+ *  =============================                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Get an item from the queue's pool, must be called locked.
+ *  \param myQueue Queue to get the item for.
+ *  \result The item, NULL if out of memory.
+ */
+static QUEUE_ITEM *queueItemAlloc (QUEUE_HEADER *myQueue)
+{
+	QUEUE_ITEM *newQueueItem;
+
+	if (myQueue -> freeItems == NULL)
+	{
+		QUEUE_SLAB *newSlab;
+		char *itemPtr;
+		int i;
+
+		if ((newSlab = malloc (sizeof (QUEUE_SLAB) + (QUEUE_SLAB_ITEMS * myQueue -> itemSize))) == NULL)
+			return NULL;
+
+		newSlab -> nextSlab = myQueue -> slabList;
+		myQueue -> slabList = newSlab;
+
+		itemPtr = (char *)(newSlab + 1);
+		for (i = 0; i < QUEUE_SLAB_ITEMS; ++i)
+		{
+			newQueueItem = (QUEUE_ITEM *)(itemPtr + (i * myQueue -> itemSize));
+			newQueueItem -> myNextPtr = myQueue -> freeItems;
+			myQueue -> freeItems = newQueueItem;
+		}
+	}
+	newQueueItem = myQueue -> freeItems;
+	myQueue -> freeItems = newQueueItem -> myNextPtr;
+	return newQueueItem;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Q U E U E  S K I P  I N S E R T                                                                                   *
+ *  ===============================                                                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Insert an item in a sorted queue after any items that are equal to it, must be called locked.
+ *  \param myQueue Queue to insert in to.
+ *  \param newQueueItem Item to insert.
+ *  \param Compare Function used to sort the queue.
+ *  \result None.
+ */
+static void queueSkipInsert (QUEUE_HEADER *myQueue, QUEUE_ITEM *newQueueItem,
+		int(*Compare)(void *item1, void *item2))
+{
+	QUEUE_ITEM *update[QUEUE_SKIP_LEVELS], *prevItem = NULL, *nextItem;
+	int level, newLevel = 1;
+
+	/*------------------------------------------------------------------------------------------------*
+     * Find the item to insert after on each level, NULL means the queue header                       *
+     *------------------------------------------------------------------------------------------------*/
+	for (level = myQueue -> skipLevel - 1; level >= 0; --level)
+	{
+		if (level)
+			nextItem = prevItem ? prevItem -> mySkipPtr[level - 1] : myQueue -> skipHead[level - 1];
+		else
+			nextItem = prevItem ? prevItem -> myNextPtr : myQueue -> firstInQueue;
+
+		while (nextItem && Compare (newQueueItem -> myData, nextItem -> myData) >= 0)
+		{
+			prevItem = nextItem;
+			nextItem = level ? prevItem -> mySkipPtr[level - 1] : prevItem -> myNextPtr;
+		}
+		update[level] = prevItem;
+	}
+
+	/*------------------------------------------------------------------------------------------------*
+     * Link in the bottom level, this is the normal queue                                             *
+     *------------------------------------------------------------------------------------------------*/
+	newQueueItem -> myPrevPtr = update[0];
+	newQueueItem -> myNextPtr = update[0] ? update[0] -> myNextPtr : myQueue -> firstInQueue;
+	if (update[0])
+		update[0] -> myNextPtr = newQueueItem;
+	else
+		myQueue -> firstInQueue = newQueueItem;
+	if (newQueueItem -> myNextPtr)
+		((QUEUE_ITEM *)newQueueItem -> myNextPtr) -> myPrevPtr = newQueueItem;
+	else
+		myQueue -> lastInQueue = newQueueItem;
+
+	/*------------------------------------------------------------------------------------------------*
+     * One in four items goes up a level                                                              *
+     *------------------------------------------------------------------------------------------------*/
+	while (newLevel < QUEUE_SKIP_LEVELS)
+	{
+		myQueue -> skipRandom ^= myQueue -> skipRandom << 13;
+		myQueue -> skipRandom ^= myQueue -> skipRandom >> 17;
+		myQueue -> skipRandom ^= myQueue -> skipRandom << 5;
+		if (myQueue -> skipRandom & 3)
+			break;
+		++newLevel;
+	}
+	while (myQueue -> skipLevel < newLevel)
+		update[myQueue -> skipLevel++] = NULL;
+
+	for (level = 1; level < newLevel; ++level)
+	{
+		if (update[level])
+		{
+			newQueueItem -> mySkipPtr[level - 1] = update[level] -> mySkipPtr[level - 1];
+			update[level] -> mySkipPtr[level - 1] = newQueueItem;
+		}
+		else
+		{
+			newQueueItem -> mySkipPtr[level - 1] = myQueue -> skipHead[level - 1];
+			myQueue -> skipHead[level - 1] = newQueueItem;
+		}
+	}
+	for (; level < QUEUE_SKIP_LEVELS; ++level)
+		newQueueItem -> mySkipPtr[level - 1] = NULL;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Q U E U E  C R E A T E  A R R A Y                                                                                 *
+ *  =================================                                                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Create a queue held in an array, so any item can be read without walking the queue.
+ *  \result A void pointer (handle) to the queue.
+ */
+void *queueCreateArray ()
+{
+	QUEUE_HEADER *newQueue;
+
+	if ((newQueue = queueCreate ()) == NULL)
+		return NULL;
+
+	if ((newQueue -> dataArray = malloc (ARRAY_START_SIZE * sizeof (void *))) == NULL)
+	{
+		queueDelete (newQueue);
+		return NULL;
+	}
+	newQueue -> arraySize = ARRAY_START_SIZE;
+	return newQueue;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Q U E U E  A R R A Y  G R O W                                                                                     *
+ *  =============================                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Make sure there is space in an array queue for one more item, must be called locked.
+ *  \param myQueue Queue to check.
+ *  \result True if there is space.
+ */
+static int queueArrayGrow (QUEUE_HEADER *myQueue)
+{
+	unsigned long i, newSize;
+	void **newArray;
+
+	if (myQueue -> itemCount < myQueue -> arraySize)
+		return 1;
+
+	newSize = myQueue -> arraySize << 1;
+	if ((newArray = malloc (newSize * sizeof (void *))) == NULL)
+		return 0;
+
+	for (i = 0; i < myQueue -> itemCount; ++i)
+		newArray[i] = ARRAY_ITEM (myQueue, i);
+
+	free (myQueue -> dataArray);
+	myQueue -> dataArray = newArray;
+	myQueue -> arraySize = newSize;
+	myQueue -> arrayHead = 0;
+	return 1;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  Q U E U E  D E L E T E                                                                                            *
@@ -189,7 +544,18 @@ void queueDelete (void *queueHandle)
 #endif
 
 	if (queueHandle)
+	{
+		QUEUE_SLAB *oldSlab;
+
+		while ((oldSlab = ((QUEUE_HEADER *)queueHandle) -> slabList) != NULL)
+		{
+			((QUEUE_HEADER *)queueHandle) -> slabList = oldSlab -> nextSlab;
+			free (oldSlab);
+		}
+		free (((QUEUE_HEADER *)queueHandle) -> dataArray);
+		free (((QUEUE_HEADER *)queueHandle) -> spscRing);
 		free (queueHandle);
+	}
 }
 
 /**********************************************************************************************************************
@@ -208,14 +574,41 @@ void *queueGet (void *queueHandle)
 	QUEUE_HEADER *myQueue = (QUEUE_HEADER *)queueHandle;
 	QUEUE_ITEM *oldQueueItem;
 	void *retn = NULL;
+	int i;
+
+	if (myQueue -> spscRing)
+		return queueRingRead (myQueue -> spscRing, 0, 1);
 
 	queueLock (myQueue);
-	if (myQueue -> firstInQueue)
+	if (myQueue -> dataArray)
+	{
+		if (myQueue -> itemCount)
+		{
+			retn = ARRAY_ITEM (myQueue, 0);
+			myQueue -> arrayHead = (myQueue -> arrayHead + 1) & (myQueue -> arraySize - 1);
+			myQueue -> itemCount --;
+			if (myQueue -> walkIndex)
+				myQueue -> walkIndex --;
+		}
+	}
+	else if (myQueue -> firstInQueue)
 	{
 		oldQueueItem = myQueue -> firstInQueue;
+		if (oldQueueItem == myQueue -> readItem)
+			myQueue -> readItem = NULL;
+		else if (myQueue -> readItem)
+			myQueue -> readIndex --;
+		if (oldQueueItem == myQueue -> walkItem)
+			myQueue -> walkItem = NULL;
 		retn = oldQueueItem -> myData;
 		myQueue -> firstInQueue = oldQueueItem -> myNextPtr;
-		free (oldQueueItem);
+		for (i = 1; i < myQueue -> skipLevel; ++i)
+		{
+			if (myQueue -> skipHead[i - 1] == oldQueueItem)
+				myQueue -> skipHead[i - 1] = oldQueueItem -> mySkipPtr[i - 1];
+		}
+		oldQueueItem -> myNextPtr = myQueue -> freeItems;
+		myQueue -> freeItems = oldQueueItem;
 
 		if (myQueue -> firstInQueue)
 			myQueue -> firstInQueue -> myPrevPtr = NULL;
@@ -230,28 +623,49 @@ void *queueGet (void *queueHandle)
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- *  Q U E U E  P U T                                                                                                  *
- *  ================                                                                                                  *
+ *  Q U E U E  T R Y  P U T                                                                                           *
+ *  =======================                                                                                           *
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
- *  \brief Put something on the queue.
+ *  \brief Put something on the queue, letting the caller know if it could not be added.
  *  \param queueHandle Hangle to save to.
  *  \param putData Thing to put on the queue.
- *  \result None.
+ *  \result True if added, false if the queue is full (single producer single consumer queue) or out of memory.
  */
-void queuePut (void *queueHandle, void *putData)
+int queueTryPut (void *queueHandle, void *putData)
 {
 	QUEUE_HEADER *myQueue = (QUEUE_HEADER *)queueHandle;
 	QUEUE_ITEM *newQueueItem;
+	int retn = 0;
 
-	if ((newQueueItem = malloc (sizeof (QUEUE_ITEM))) == NULL)
-		return;
+	if (myQueue -> spscRing)
+		return queueRingPut (myQueue -> spscRing, putData);
 
+	if (myQueue -> dataArray)
+	{
+		queueLock (myQueue);
+		if (queueArrayGrow (myQueue))
+		{
+			ARRAY_ITEM (myQueue, myQueue -> itemCount) = putData;
+			myQueue -> itemCount ++;
+			retn = 1;
+		}
+		queueUnLock (myQueue);
+		return retn;
+	}
+
+	queueLock (myQueue);
+	if ((newQueueItem = queueItemAlloc (myQueue)) == NULL)
+	{
+		queueUnLock (myQueue);
+		return 0;
+	}
 	newQueueItem -> myNextPtr = newQueueItem -> myPrevPtr = NULL;
 	newQueueItem -> myData = putData;
+	if (myQueue -> skipLevel)
+		memset (newQueueItem -> mySkipPtr, 0, (QUEUE_SKIP_LEVELS - 1) * sizeof (void *));
 
-	queueLock (myQueue);
 	if (myQueue -> lastInQueue)
 	{
 		myQueue -> lastInQueue -> myNextPtr = newQueueItem;
@@ -263,6 +677,24 @@ void queuePut (void *queueHandle, void *putData)
 
 	myQueue -> itemCount ++;
 	queueUnLock (myQueue);
+	return 1;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Q U E U E  P U T                                                                                                  *
+ *  ================                                                                                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Put something on the queue.
+ *  \param queueHandle Hangle to save to.
+ *  \param putData Thing to put on the queue.
+ *  \result None.
+ */
+void queuePut (void *queueHandle, void *putData)
+{
+	queueTryPut (queueHandle, putData);
 }
 
 /**********************************************************************************************************************
@@ -282,13 +714,38 @@ void queuePush (void *queueHandle, void *putData)
 	QUEUE_HEADER *myQueue = (QUEUE_HEADER *)queueHandle;
 	QUEUE_ITEM *newQueueItem;
 
-	if ((newQueueItem = malloc (sizeof (QUEUE_ITEM))) == NULL)
+	if (myQueue -> spscRing)
+	{
+		queueRingPut (myQueue -> spscRing, putData);
+		return;
+	}
+	if (myQueue -> dataArray)
+	{
+		queueLock (myQueue);
+		if (queueArrayGrow (myQueue))
+		{
+			myQueue -> arrayHead = (myQueue -> arrayHead - 1) & (myQueue -> arraySize - 1);
+			myQueue -> dataArray[myQueue -> arrayHead] = putData;
+			myQueue -> itemCount ++;
+			myQueue -> walkIndex ++;
+		}
+		queueUnLock (myQueue);
 		return;
+	}
 
+	queueLock (myQueue);
+	if ((newQueueItem = queueItemAlloc (myQueue)) == NULL)
+	{
+		queueUnLock (myQueue);
+		return;
+	}
 	newQueueItem -> myNextPtr = newQueueItem -> myPrevPtr = NULL;
 	newQueueItem -> myData = putData;
+	if (myQueue -> skipLevel)
+		memset (newQueueItem -> mySkipPtr, 0, (QUEUE_SKIP_LEVELS - 1) * sizeof (void *));
 
-	queueLock (myQueue);
+	if (myQueue -> readItem)
+		myQueue -> readIndex ++;
 	if (myQueue -> firstInQueue)
 	{
 		myQueue -> firstInQueue -> myPrevPtr = newQueueItem;
@@ -321,14 +778,72 @@ void queuePutSort (void *queueHandle, void *putData,
 	QUEUE_HEADER *myQueue = (QUEUE_HEADER *)queueHandle;
 	QUEUE_ITEM *newQueueItem;
 
-	if ((newQueueItem = malloc (sizeof (QUEUE_ITEM))) == NULL)
+	if (myQueue -> spscRing)
+	{
+		queueRingPut (myQueue -> spscRing, putData);
+		return;
+	}
+	if (myQueue -> dataArray)
+	{
+		unsigned long low = 0, high, i;
+
+		queueLock (myQueue);
+		if (queueArrayGrow (myQueue))
+		{
+			/*----------------------------------------------------------------------------------------*
+             * Binary search for the first item that sorts after the new one                          *
+             *----------------------------------------------------------------------------------------*/
+			high = myQueue -> itemCount;
+			while (low < high)
+			{
+				unsigned long mid = (low + high) >> 1;
+
+				if (Compare (putData, ARRAY_ITEM (myQueue, mid)) < 0)
+					high = mid;
+				else
+					low = mid + 1;
+			}
+
+			/*----------------------------------------------------------------------------------------*
+             * Move which ever end of the ring buffer is shorter                                      *
+             *----------------------------------------------------------------------------------------*/
+			if (low < myQueue -> itemCount / 2)
+			{
+				myQueue -> arrayHead = (myQueue -> arrayHead - 1) & (myQueue -> arraySize - 1);
+				for (i = 0; i < low; ++i)
+					ARRAY_ITEM (myQueue, i) = ARRAY_ITEM (myQueue, i + 1);
+			}
+			else
+			{
+				for (i = myQueue -> itemCount; i > low; --i)
+					ARRAY_ITEM (myQueue, i) = ARRAY_ITEM (myQueue, i - 1);
+			}
+			ARRAY_ITEM (myQueue, low) = putData;
+			myQueue -> itemCount ++;
+			if (low < myQueue -> walkIndex)
+				myQueue -> walkIndex ++;
+		}
+		queueUnLock (myQueue);
 		return;
+	}
 
+	queueLock (myQueue);
+	if ((newQueueItem = queueItemAlloc (myQueue)) == NULL)
+	{
+		queueUnLock (myQueue);
+		return;
+	}
 	newQueueItem -> myNextPtr = newQueueItem -> myPrevPtr = NULL;
 	newQueueItem -> myData = putData;
+	if (myQueue -> skipLevel)
+		memset (newQueueItem -> mySkipPtr, 0, (QUEUE_SKIP_LEVELS - 1) * sizeof (void *));
 
-	queueLock (myQueue);
-	if (myQueue -> firstInQueue)
+	myQueue -> readItem = NULL;
+	if (myQueue -> skipLevel)
+	{
+		queueSkipInsert (myQueue, newQueueItem, Compare);
+	}
+	else if (myQueue -> firstInQueue)
 	{
 		QUEUE_ITEM *currentItem = myQueue -> firstInQueue;
 
@@ -383,18 +898,121 @@ void queuePutSort (void *queueHandle, void *putData,
 void *queueRead (void *queueHandle, int item)
 {
 	QUEUE_HEADER *myQueue = (QUEUE_HEADER *)queueHandle;
-	QUEUE_ITEM *currentItem = myQueue -> firstInQueue;
+	QUEUE_ITEM *currentItem;
+	unsigned long index = 0, want = (item < 0 ? 0 : (unsigned long)item);
 	void *retn = NULL;
 
+	if (myQueue -> spscRing)
+		return queueRingRead (myQueue -> spscRing, want, 0);
+
 	queueLock (myQueue);
-	while (currentItem && item > 0)
+	if (myQueue -> dataArray)
 	{
-		currentItem = currentItem -> myNextPtr;
-		item --;
+		if (want < myQueue -> itemCount)
+			retn = ARRAY_ITEM (myQueue, want);
 	}
-	if (currentItem)
-		retn = currentItem -> myData;
+	else
+	{
+		/*--------------------------------------------------------------------------------------------*
+         * Carry on from the last item read, so reading in order does not walk the whole queue        *
+         *--------------------------------------------------------------------------------------------*/
+		currentItem = myQueue -> firstInQueue;
+		if (myQueue -> readItem && want >= myQueue -> readIndex)
+		{
+			currentItem = myQueue -> readItem;
+			index = myQueue -> readIndex;
+		}
+		while (currentItem && index < want)
+		{
+			currentItem = currentItem -> myNextPtr;
+			index ++;
+		}
+		if (currentItem)
+		{
+			myQueue -> readItem = currentItem;
+			myQueue -> readIndex = index;
+			retn = currentItem -> myData;
+		}
+	}
+	queueUnLock (myQueue);
+	return retn;
+}
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Q U E U E  R E A D  F I R S T                                                                                     *
+ *  =============================                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Start walking the queue, the queue should not be changed while walking it other than adding to the end.
+ *  The walk keeps its own place, so queueRead can be called during it.
+ *  \param queueHandle Handle to read from.
+ *  \result The first item on the queue, NULL if empty.
+ */
+void *queueReadFirst (void *queueHandle)
+{
+	QUEUE_HEADER *myQueue = (QUEUE_HEADER *)queueHandle;
+	void *retn = NULL;
+
+	if (myQueue -> spscRing)
+	{
+		myQueue -> walkIndex = 1;
+		return queueRingRead (myQueue -> spscRing, 0, 0);
+	}
+
+	queueLock (myQueue);
+	if (myQueue -> dataArray)
+	{
+		myQueue -> walkIndex = 1;
+		if (myQueue -> itemCount)
+			retn = ARRAY_ITEM (myQueue, 0);
+	}
+	else
+	{
+		myQueue -> walkItem = myQueue -> firstInQueue;
+		if (myQueue -> walkItem)
+			retn = myQueue -> walkItem -> myData;
+	}
+	queueUnLock (myQueue);
+	return retn;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Q U E U E  R E A D  N E X T                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Carry on walking the queue started with queueReadFirst.
+ *  \param queueHandle Handle to read from.
+ *  \result The next item on the queue, NULL at the end.
+ */
+void *queueReadNext (void *queueHandle)
+{
+	QUEUE_HEADER *myQueue = (QUEUE_HEADER *)queueHandle;
+	void *retn = NULL;
+
+	if (myQueue -> spscRing)
+	{
+		if ((retn = queueRingRead (myQueue -> spscRing, myQueue -> walkIndex, 0)) != NULL)
+			myQueue -> walkIndex ++;
+		return retn;
+	}
+
+	queueLock (myQueue);
+	if (myQueue -> dataArray)
+	{
+		if (myQueue -> walkIndex < myQueue -> itemCount)
+			retn = ARRAY_ITEM (myQueue, myQueue -> walkIndex++);
+	}
+	else if (myQueue -> walkItem)
+	{
+		myQueue -> walkItem = myQueue -> walkItem -> myNextPtr;
+		if (myQueue -> walkItem)
+			retn = myQueue -> walkItem -> myData;
+	}
 	queueUnLock (myQueue);
 	return retn;
 }
@@ -457,6 +1075,12 @@ unsigned long queueGetItemCount (void *queueHandle)
 	QUEUE_HEADER *myQueue = (QUEUE_HEADER *)queueHandle;
 	unsigned long retn;
 
+	if (myQueue -> spscRing)
+	{
+		retn = __atomic_load_n (&myQueue -> spscRing -> readIndex, __ATOMIC_ACQUIRE);
+		return __atomic_load_n (&myQueue -> spscRing -> writeIndex, __ATOMIC_ACQUIRE) - retn;
+	}
+
 	queueLock (myQueue);
 	retn = myQueue -> itemCount;
 	queueUnLock (myQueue);
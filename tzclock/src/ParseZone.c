@@ -131,15 +131,14 @@ int getAreaAndCity (char *inBuffer, char *area, char *subArea, char *city)
  */
 AREAINFO *findAreaInfo (void *areaInfoList, char *area)
 {
-	int i = 0;
-	AREAINFO *retnAreaInfo;
+	AREAINFO *retnAreaInfo = (AREAINFO *)queueReadFirst (areaInfoList);
 
-	while ((retnAreaInfo = (AREAINFO *)queueRead (areaInfoList, i)) != NULL)
+	while (retnAreaInfo != NULL)
 	{
 		if (strcmp (retnAreaInfo -> areaName, area) == 0)
 			break;
 
-		i++;
+		retnAreaInfo = (AREAINFO *)queueReadNext (areaInfoList);
 	}
 	return retnAreaInfo;
 }
@@ -244,8 +243,8 @@ int addAreaAndCity (void *areaInfoList, char *area, char *subArea, char *city)
 		}
 		strcpy (tempArea, area);
 		areaInfo -> areaName = tempArea;
-		areaInfo -> cityList = queueCreate();
-		areaInfo -> subAreaList = queueCreate();
+		areaInfo -> cityList = queueCreateSorted();
+		areaInfo -> subAreaList = queueCreateSorted();
 		areaCount ++;
 
 		queuePutSort (areaInfoList, areaInfo, compareArea);
@@ -266,7 +265,7 @@ int addAreaAndCity (void *areaInfoList, char *area, char *subArea, char *city)
 			}
 			strcpy (tempSubArea, subArea);
 			subAreaInfo -> areaName = tempSubArea;
-			subAreaInfo -> cityList = queueCreate();
+			subAreaInfo -> cityList = queueCreateSorted();
 			subAreaInfo -> subAreaList = NULL;
 			subAreaCount ++;
 
@@ -476,11 +475,11 @@ int buildAreaInfo (void *areaInfoList)
  */
 void splitCityList (void *areaInfoList)
 {
-	int readItem = 0;
 	AREAINFO *areaInfo, *subAreaInfo = NULL;
 	char *cityName;
 
-	while ((areaInfo = (AREAINFO *)queueRead (areaInfoList, readItem)) != NULL)
+	for (areaInfo = (AREAINFO *)queueReadFirst (areaInfoList); areaInfo != NULL;
+			areaInfo = (AREAINFO *)queueReadNext (areaInfoList))
 	{
 		if (queueGetItemCount (areaInfo -> cityList) > 20)
 		{
@@ -512,7 +511,7 @@ void splitCityList (void *areaInfoList)
 				}
 				strcpy (tempSubArea, subArea);
 				subAreaInfo -> areaName = tempSubArea;
-				subAreaInfo -> cityList = queueCreate();
+				subAreaInfo -> cityList = queueCreateSorted();
 				subAreaInfo -> subAreaList = NULL;
 				subAreaInfo -> dummyArea = 1;
 				queuePut (areaInfo -> subAreaList, subAreaInfo);
@@ -526,7 +525,6 @@ void splitCityList (void *areaInfoList)
 				count = queueGetItemCount (areaInfo -> cityList);
 			}
 		}
-		++readItem;
 	}
 }
 
@@ -547,7 +545,7 @@ int parseZone (void)
 	char inBuffer[161], area[41], subArea[41], city[41];
 	void *areaInfoList;
 
-	areaInfoList = queueCreate ();
+	areaInfoList = queueCreateArray ();
 	if ((inFile = fopen ("/usr/share/zoneinfo/zone.tab", "r")) == NULL)
 	{
 		inFile = fopen ("/usr/share/lib/zoneinfo/tab/zone_sun.tab", "r");
@@ -101,6 +101,42 @@ char displayString[TXT_COUNT][101] =
 	"1Min"							/* Sub second                   */ /* Y:22 */
 };
 
+/*----------------------------------------------------------------------------------------------------*
+ * Display strings are compiled into a list of literal text, strftime fields and our own fields.      *
+ *----------------------------------------------------------------------------------------------------*/
+typedef struct _formatOp
+{
+	char opType;					/* 0 literal, '%' strftime, else one of *#@&$ */
+	unsigned char length;			/* Length of literal text */
+	short offset;					/* Start of literal text in the format */
+	char command[4];				/* strftime field, "%X" or "%-d" */
+}
+FORMAT_OP;
+
+typedef struct _formatProg
+{
+	int compiled;
+	int noCache;					/* Uses the stopwatch, timer or alarm */
+	int useSeconds;					/* Changes every second */
+	int opCount;
+	FORMAT_OP ops[101];
+}
+FORMAT_PROG;
+
+typedef struct _formatCache
+{
+	int generation;
+	int maxSize;
+	int currentTZ;
+	int keyTime[8];
+	const char *keyZone;
+	char output[201];
+}
+FORMAT_CACHE;
+
+static FORMAT_PROG formatProgs[TXT_COUNT];
+static int formatGeneration = 1;
+
 /*----------------------------------------------------------------------------------------------------*
  * If we cannot find a stock clock icon then use this built in one.                                   *
  *----------------------------------------------------------------------------------------------------*/
@@ -260,6 +296,10 @@ static int keyPressFaceNum		= -1;
 static int stopwatchActive		=  0;
 static time_t lastTime			= -1;
 static int bounceSec			=  0;
+static guint tickSource			=  0;
+static int inTick				=  0;
+static guint frameTickID		=  0;
+static gint64 frameWallTime		= -1;
 
 /*----------------------------------------------------------------------------------------------------*
  *                                                                                                    *
@@ -323,6 +363,12 @@ static void howTo					(FILE * outFile, char *format, ...);
 static void checkForAlarm			(FACE_SETTINGS *faceSetting, struct tm *tm);
 static void checkForTimer			(FACE_SETTINGS *faceSetting);
 static void prepareForPopup 		(void);
+static int getFaceLocalTime			(FACE_SETTINGS *faceSetting, time_t t, struct tm *tm);
+static int getFaceNextTick			(FACE_SETTINGS *faceSetting, struct tm *tm, int msNow);
+static int getWatchPositions		(FACE_SETTINGS *faceSetting);
+static void checkFrameTick			(void);
+static gint64 getWallTime			(void);
+static void compileFormat			(int stringNumber);
 
 static gboolean clockTickCallback	(gpointer data);
 static gboolean windowClickCallback (GtkWidget * widget, GdkEventButton * event);
@@ -606,6 +652,7 @@ setTimeZoneCallback (guint data)
 	sprintf (value, "timezone_city_%d", clockInst.currentFace + 1);
 	configSetValue (value, clockInst.faceSettings[clockInst.currentFace] -> currentTZCity);
 	lastTime = -1;
+	tickWakeUp ();
 }
 
 /**********************************************************************************************************************
@@ -768,6 +815,7 @@ alarmCallback (guint data)
 	sprintf (value, "alarm_%d", clockInst.currentFace + 1);
 	configSetBoolValue (value, newVal);
 	lastTime = -1;
+	tickWakeUp ();
 	prepareForPopup ();
 	createMenu (mainMenuDesc, clockInst.accelGroup, FALSE);
 }
@@ -902,6 +950,7 @@ alarmSetCallback (guint data)
 		configSetBoolValue (value, clockInst.faceSettings[clockInst.currentFace] -> alarmInfo.onlyWeekdays);
 		alarmSetAngle (clockInst.currentFace);
 		lastTime = -1;
+		tickWakeUp ();
 	}
 	gtk_widget_destroy (dialog);
 }
@@ -1007,6 +1056,7 @@ windowClickCallback (GtkWidget * widget, GdkEventButton * event)
 	{
 		clockInst.currentFace = ((int)event -> x / clockInst.dialConfig.dialSize) + (((int)event -> y / clockInst.dialConfig.dialSize) * clockInst.dialConfig.dialWidth);
 		lastTime = -1;
+		tickWakeUp ();
 
 		switch (event->button)
 		{
@@ -1144,12 +1194,94 @@ windowKeyCallback (GtkWidget * widget, GdkEventKey * event)
 			{
 				clockInst.currentFace = keyPressFaceNum;
 				lastTime = -1;
+				tickWakeUp ();
 			}
 		}
 	}
 	return TRUE;
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  G E T  W A T C H  P O S I T I O N S                                                                               *
+ *  ===================================                                                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Calculate the positions of the stopwatch or timer hands.
+ *  \param faceSetting Settings for the face.
+ *  \result True if changed.
+ */
+static int getWatchPositions (FACE_SETTINGS *faceSetting)
+{
+	int update = 0;
+	unsigned short angle;
+
+	if (faceSetting -> stopwatch)
+	{
+		int swTime = getStopwatchTime(faceSetting);
+		/*--------------------------------------------------------------------------------------------*
+         * Calculate stopwatch tenths hand position                                                   *
+         *--------------------------------------------------------------------------------------------*/
+		angle = (swTime % 100) * 12;
+		if (angle != faceSetting -> handPosition[HAND_STOPWT])
+		{
+			faceSetting -> handPosition[HAND_STOPWT] = angle;
+			update = 1;
+		}
+		/*--------------------------------------------------------------------------------------------*
+         * Calculate stopwatch seconds hand position                                                  *
+         *--------------------------------------------------------------------------------------------*/
+		angle = ((swTime / 100) * 20) % 1200;
+		if (angle != faceSetting -> handPosition[HAND_STOPWS])
+		{
+			faceSetting -> handPosition[HAND_STOPWS] = angle;
+			update = 1;
+		}
+		/*--------------------------------------------------------------------------------------------*
+         * Calculate stopwatch minute hand position                                                   *
+         *--------------------------------------------------------------------------------------------*/
+		angle = ((swTime / 600) * 4) % 1200;
+		if (angle != faceSetting -> handPosition[HAND_STOPWM])
+		{
+			faceSetting -> handPosition[HAND_STOPWM] = angle;
+			update = 1;
+		}
+	}
+	else if (faceSetting -> timer)
+	{
+		int cdTime = getTimerTime(faceSetting);
+		/*--------------------------------------------------------------------------------------------*
+         * Calculate timer second hand position                                                       *
+         *--------------------------------------------------------------------------------------------*/
+		angle = (cdTime % 60) * 20;
+		if (angle != faceSetting -> handPosition[HAND_STOPWS])
+		{
+			faceSetting -> handPosition[HAND_STOPWS] = angle;
+			update = 1;
+		}
+		/*--------------------------------------------------------------------------------------------*
+         * Calculate timer minute hand position                                                       *
+         *--------------------------------------------------------------------------------------------*/
+		angle = ((cdTime / 6) % 300) * 4;
+		if (angle != faceSetting -> handPosition[HAND_STOPWM])
+		{
+			faceSetting -> handPosition[HAND_STOPWM] = angle;
+			update = 1;
+		}
+		/*--------------------------------------------------------------------------------------------*
+         * Calculate timer hours hand position                                                        *
+         *--------------------------------------------------------------------------------------------*/
+		angle = (cdTime / 90) * 5;
+		if (angle != faceSetting -> handPosition[HAND_STOPWT])
+		{
+			faceSetting -> handPosition[HAND_STOPWT] = angle;
+			update = 1;
+		}
+	}
+	return update;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  G E T  H A N D  P O S I T I O N S                                                                                 *
@@ -1282,68 +1414,17 @@ int getHandPositions (int face, FACE_SETTINGS *faceSetting, struct tm *tm, time_
 			update = 1;
 		}
 	}
-
-	if (faceSetting -> stopwatch)
+	/*------------------------------------------------------------------------------------------------*
+     * Running watches are moved by the frame clock when it is going. That stops while the window is  *
+     * hidden, so still look here for a running timer that has finished.                              *
+     *------------------------------------------------------------------------------------------------*/
+	if (frameTickID && faceSetting -> timer && faceSetting -> swStartTime != -1)
 	{
-		int swTime = getStopwatchTime(faceSetting);
-		/*--------------------------------------------------------------------------------------------*
-         * Calculate stopwatch tenths hand position                                                   *
-         *--------------------------------------------------------------------------------------------*/
-		angle = (swTime % 100) * 12;
-		if (angle != faceSetting -> handPosition[HAND_STOPWT])
-		{
-			faceSetting -> handPosition[HAND_STOPWT] = angle;
-			update = 1;
-		}
-		/*--------------------------------------------------------------------------------------------*
-         * Calculate stopwatch seconds hand position                                                   *
-         *--------------------------------------------------------------------------------------------*/
-		angle = ((swTime / 100) * 20) % 1200;
-		if (angle != faceSetting -> handPosition[HAND_STOPWS])
-		{
-			faceSetting -> handPosition[HAND_STOPWS] = angle;
-			update = 1;
-		}
-		/*--------------------------------------------------------------------------------------------*
-         * Calculate stopwatch minute hand position                                                   *
-         *--------------------------------------------------------------------------------------------*/
-		angle = ((swTime / 600) * 4) % 1200;
-		if (angle != faceSetting -> handPosition[HAND_STOPWM])
-		{
-			faceSetting -> handPosition[HAND_STOPWM] = angle;
-			update = 1;
-		}
+		getTimerTime (faceSetting);
 	}
-	else if (faceSetting -> timer)
+	if (!(frameTickID && faceSetting -> swStartTime != -1) && getWatchPositions (faceSetting))
 	{
-		int cdTime = getTimerTime(faceSetting);
-		/*--------------------------------------------------------------------------------------------*
-         * Calculate timer second hand position                                                   *
-         *--------------------------------------------------------------------------------------------*/
-		angle = (cdTime % 60) * 20;
-		if (angle != faceSetting -> handPosition[HAND_STOPWS])
-		{
-			faceSetting -> handPosition[HAND_STOPWS] = angle;
-			update = 1;
-		}
-		/*--------------------------------------------------------------------------------------------*
-         * Calculate timer minute hand position                                                   *
-         *--------------------------------------------------------------------------------------------*/
-		angle = ((cdTime / 6) % 300) * 4;
-		if (angle != faceSetting -> handPosition[HAND_STOPWM])
-		{
-			faceSetting -> handPosition[HAND_STOPWM] = angle;
-			update = 1;
-		}
-		/*--------------------------------------------------------------------------------------------*
-         * Calculate timer hours hand position                                                   *
-         *--------------------------------------------------------------------------------------------*/
-		angle = (cdTime / 90) * 5;
-		if (angle != faceSetting -> handPosition[HAND_STOPWT])
-		{
-			faceSetting -> handPosition[HAND_STOPWT] = angle;
-			update = 1;
-		}
+		update = 1;
 	}
 	if (faceSetting -> updateFace)
 	{
@@ -1353,6 +1434,155 @@ int getHandPositions (int face, FACE_SETTINGS *faceSetting, struct tm *tm, time_
 	return update;
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  G E T  F A C E  N E X T  T I C K                                                                                  *
+ *  ================================                                                                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Work out how long until something visible on a face next moves.
+ *  \param faceSetting Face settings.
+ *  \param tm Local time shown on the face.
+ *  \param msNow Milliseconds into the current wall clock second.
+ *  \result Milliseconds to wait.
+ */
+static int getFaceNextTick (FACE_SETTINGS *faceSetting, struct tm *tm, int msNow)
+{
+	int toSecond = 1001 - msNow, delay;
+
+	/*------------------------------------------------------------------------------------------------*
+     * The minute hand moves every 3 seconds, the hour hand on the same steps. With nothing shown     *
+     * still look once a minute for the alarm and the window title.                                   *
+     *------------------------------------------------------------------------------------------------*/
+	if (faceSetting -> showTime)
+		delay = toSecond + (1000 * (2 - (tm -> tm_sec % 3)));
+	else
+		delay = toSecond + (1000 * (59 - tm -> tm_sec));
+
+	if (faceSetting -> showTime && faceSetting -> showSeconds)
+	{
+		if (clockInst.showBounceSec && bounceSec && msNow < 50)
+			delay = 51 - msNow;
+		else if (toSecond < delay)
+			delay = toSecond;
+	}
+	if (faceSetting -> timer && faceSetting -> swStartTime != -1 && toSecond < delay)
+	{
+		delay = toSecond;
+	}
+
+	/*------------------------------------------------------------------------------------------------*
+     * A running stopwatch is moved by the frame clock, only fall back to a 50ms step without one.    *
+     *------------------------------------------------------------------------------------------------*/
+	if (faceSetting -> stopwatch && faceSetting -> swStartTime != -1 && !frameTickID && delay > 50)
+	{
+		delay = 50;
+	}
+	if (faceSetting -> stepping && delay > 50)
+	{
+		delay = 50;
+	}
+	return delay;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  F R A M E  T I C K  C A L L B A C K                                                                               *
+ *  ===================================                                                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Called by the frame clock while a stopwatch or timer runs, moves the hands for the frame time.
+ *  \param widget Drawing area.
+ *  \param frameClock Frame clock of the window.
+ *  \param data Not used.
+ *  \result G_SOURCE_REMOVE once nothing is running.
+ */
+static gboolean frameTickCallback (GtkWidget *widget, GdkFrameClock *frameClock, gpointer data)
+{
+	int i, running = 0, faceCount = clockInst.dialConfig.dialHeight * clockInst.dialConfig.dialWidth;
+	int dialSize = clockInst.dialConfig.dialSize, dialWidth = clockInst.dialConfig.dialWidth;
+
+	/*------------------------------------------------------------------------------------------------*
+     * Frame times are monotonic, the watches count in wall clock time                                *
+     *------------------------------------------------------------------------------------------------*/
+	frameWallTime = gdk_frame_clock_get_frame_time (frameClock) + g_get_real_time () - g_get_monotonic_time ();
+
+	for (i = 0; i < faceCount; ++i)
+	{
+		FACE_SETTINGS *faceSetting = clockInst.faceSettings[i];
+
+		if ((faceSetting -> stopwatch || faceSetting -> timer) && faceSetting -> swStartTime != -1)
+		{
+			++running;
+			if (getWatchPositions (faceSetting))
+			{
+				gtk_widget_queue_draw_area (widget, (i % dialWidth) * dialSize, (i / dialWidth) * dialSize,
+						dialSize, dialSize);
+			}
+		}
+	}
+	frameWallTime = -1;
+
+	if (!running)
+	{
+		frameTickID = 0;
+		return G_SOURCE_REMOVE;
+	}
+	return G_SOURCE_CONTINUE;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  C H E C K  F R A M E  T I C K                                                                                     *
+ *  =============================                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Start the frame clock callback if a stopwatch or timer has started running.
+ *  \result None.
+ */
+static void checkFrameTick (void)
+{
+	int i, faceCount = clockInst.dialConfig.dialHeight * clockInst.dialConfig.dialWidth;
+
+	if (frameTickID || !clockInst.dialConfig.drawingArea)
+		return;
+
+	for (i = 0; i < faceCount; ++i)
+	{
+		FACE_SETTINGS *faceSetting = clockInst.faceSettings[i];
+
+		if ((faceSetting -> stopwatch || faceSetting -> timer) && faceSetting -> swStartTime != -1)
+		{
+			frameTickID = gtk_widget_add_tick_callback (clockInst.dialConfig.drawingArea, frameTickCallback, NULL, NULL);
+			break;
+		}
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  T I C K  W A K E  U P                                                                                             *
+ *  =====================                                                                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Run the tick now rather than waiting for the next hand to move.
+ *  \result None.
+ */
+void tickWakeUp (void)
+{
+	if (inTick)
+		return;
+
+	if (tickSource)
+		g_source_remove (tickSource);
+
+	tickSource = g_timeout_add (0, clockTickCallback, NULL);
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  C L O C K  T I C K  C A L L B A C K                                                                               *
@@ -1360,53 +1590,87 @@ int getHandPositions (int face, FACE_SETTINGS *faceSetting, struct tm *tm, time_
  *                                                                                                                    *
  **********************************************************************************************************************/
 /**
- *  \brief Called on the timer to update the face.
+ *  \brief Called on the timer to update the faces, then sleeps until the next hand is due to move.
  *  \param data Not used.
- *  \result Always true.
+ *  \result FALSE, the timer is added again for the next deadline.
  */
 gboolean
 clockTickCallback (gpointer data)
 {
 	struct tm tm;
 	struct timeval tv;
-	time_t t = time (NULL);
-	int update = 0, i, faceCount = clockInst.dialConfig.dialHeight * clockInst.dialConfig.dialWidth;
+	time_t t;
+	gint64 now = g_get_monotonic_time () / 1000, nextWake = G_MAXINT64;
+	int update = 0, redrawAll = 0, i, faceCount = clockInst.dialConfig.dialHeight * clockInst.dialConfig.dialWidth;
+	int dialSize = clockInst.dialConfig.dialSize, dialWidth = clockInst.dialConfig.dialWidth, msNow;
+
+	tickSource = 0;
+	inTick = 1;
+
+	gettimeofday (&tv, NULL);
+	t = tv.tv_sec;
+	msNow = tv.tv_usec / 1000;
 
 	if (clockInst.forceTime != -1)
 		t = clockInst.forceTime;
 	if (lastTime == -1)
-		update = 1;
+		redrawAll = 1;
 	lastTime = t;
 
-	tv.tv_sec = 0;
 	for (i = 0; i < faceCount; ++i)
 	{
 		FACE_SETTINGS *faceSetting = clockInst.faceSettings[i];
 
 		if (faceSetting -> stepping || (faceSetting -> stopwatch && faceSetting -> swStartTime != -1) ||
 				(faceSetting -> timer && faceSetting -> swStartTime != -1) ||
-				faceSetting -> timeShown != t || faceSetting -> updateFace || bounceSec)
+				faceSetting -> timeShown != t || faceSetting -> updateFace || bounceSec ||
+				faceSetting -> nextTick <= now)
 		{
 			getTheFaceTime (faceSetting, &t, &tm);
 			checkForAlarm (faceSetting, &tm);
 			if (clockInst.showBounceSec && faceSetting -> showSeconds)
 			{
-				if (tv.tv_sec == 0)
-					gettimeofday(&tv, NULL);
 				bounceSec = tv.tv_usec < 50000 ? 1 : 0;
 			}
-			update += getHandPositions (i, faceSetting, &tm, t);
+			if (getHandPositions (i, faceSetting, &tm, t))
+			{
+				/*------------------------------------------------------------------------------------*
+                 * Only redraw the faces that changed                                                 *
+                 *------------------------------------------------------------------------------------*/
+				if (clockInst.dialConfig.drawingArea && !redrawAll)
+				{
+					gtk_widget_queue_draw_area (clockInst.dialConfig.drawingArea, (i % dialWidth) * dialSize,
+							(i / dialWidth) * dialSize, dialSize, dialSize);
+				}
+				++update;
+			}
 			faceSetting -> timeShown = t;
+			faceSetting -> nextTick = now + getFaceNextTick (faceSetting, &tm, msNow);
+		}
+		if (faceSetting -> nextTick < nextWake)
+		{
+			nextWake = faceSetting -> nextTick;
 		}
 	}
-	if (update)
+	if (redrawAll)
 	{
 		if (clockInst.dialConfig.drawingArea)
 		{
 			gtk_widget_queue_draw (clockInst.dialConfig.drawingArea);
 		}
 	}
-	return TRUE;
+	checkFrameTick ();
+	inTick = 0;
+
+	/*------------------------------------------------------------------------------------------------*
+     * Sleep until the first face needs to move, lined up on the wall clock second                    *
+     *------------------------------------------------------------------------------------------------*/
+	if (nextWake != G_MAXINT64)
+	{
+		now = g_get_monotonic_time () / 1000;
+		tickSource = g_timeout_add (nextWake > now ? nextWake - now : 0, clockTickCallback, NULL);
+	}
+	return FALSE;
 }
 
 /**********************************************************************************************************************
@@ -1426,6 +1690,7 @@ gboolean
 focusInEvent (GtkWidget *widget, GdkEventFocus *event, gpointer data)
 {
 	lastTime = -1;
+	tickWakeUp ();
 	clockInst.weHaveFocus = 1;
 	return TRUE;
 }
@@ -1447,6 +1712,7 @@ gboolean
 focusOutEvent (GtkWidget *widget, GdkEventFocus *event, gpointer data)
 {
 	lastTime = -1;
+	tickWakeUp ();
 	clockInst.weHaveFocus = 0;
 	return TRUE;
 }
@@ -1476,6 +1742,7 @@ userActive (GtkWidget *widget, GdkEvent* event, gpointer data)
 	{
 		clockInst.toolTipFace = newFace;
 		lastTime = -1;
+		tickWakeUp ();
 	}
 	return TRUE;
 }
@@ -1500,6 +1767,7 @@ showTimeCallback (guint data)
 	sprintf (value, "show_time_%d", clockInst.currentFace + 1);
 	configSetBoolValue (value, clockInst.faceSettings[clockInst.currentFace] -> showTime);
 	clockInst.faceSettings[clockInst.currentFace] -> updateFace = true;
+	tickWakeUp ();
 }
 
 /**********************************************************************************************************************
@@ -1522,6 +1790,7 @@ showSecondsCallback (guint data)
 	sprintf (value, "show_seconds_%d", clockInst.currentFace + 1);
 	configSetBoolValue (value, clockInst.faceSettings[clockInst.currentFace] -> showSeconds);
 	clockInst.faceSettings[clockInst.currentFace] -> updateFace = true;
+	tickWakeUp ();
 }
 
 /**********************************************************************************************************************
@@ -1544,6 +1813,7 @@ subSecondCallback (guint data)
 	sprintf (value, "sub_second_%d", clockInst.currentFace + 1);
 	configSetBoolValue (value, clockInst.faceSettings[clockInst.currentFace] -> subSecond);
 	clockInst.faceSettings[clockInst.currentFace] -> updateFace = true;
+	tickWakeUp ();
 }
 
 /**********************************************************************************************************************
@@ -1576,6 +1846,7 @@ stopwatchCallback (guint data)
 	clockInst.faceSettings[clockInst.currentFace] -> swRunTime = 0;
 	clockInst.faceSettings[clockInst.currentFace] -> updateFace = true;
 	lastTime = -1;
+	tickWakeUp ();
 
 	prepareForPopup ();
 	createMenu (mainMenuDesc, clockInst.accelGroup, FALSE);
@@ -1608,6 +1879,7 @@ swStartCallback (guint data)
 				clockInst.faceSettings[clockInst.currentFace] -> updateFace = true;
 				stopwatchActive ++;
 				lastTime = -1;
+				tickWakeUp ();
 			}
 			else
 			{
@@ -1619,6 +1891,7 @@ swStartCallback (guint data)
 				clockInst.faceSettings[clockInst.currentFace] -> updateFace = true;
 				stopwatchActive --;
 				lastTime = -1;
+				tickWakeUp ();
 			}
 		}
 	}
@@ -1651,6 +1924,7 @@ swResetCallback (guint data)
 			swStartCallback (data);
 		}
 		lastTime = -1;
+		tickWakeUp ();
 	}
 }
 
@@ -1690,6 +1964,7 @@ timerCallback (guint data)
 	faceSetting -> swRunTime = 0;
 	faceSetting -> updateFace = true;
 	lastTime = -1;
+	tickWakeUp ();
 
 	prepareForPopup ();
 	createMenu (mainMenuDesc, clockInst.accelGroup, FALSE);
@@ -1726,6 +2001,7 @@ tmStartCallback (guint data)
 				faceSetting -> updateFace = true;
 				stopwatchActive ++;
 				lastTime = -1;
+				tickWakeUp ();
 			}
 			else
 			{
@@ -1734,6 +2010,7 @@ tmStartCallback (guint data)
 				faceSetting -> updateFace = true;
 				stopwatchActive --;
 				lastTime = -1;
+				tickWakeUp ();
 			}
 		}
 	}
@@ -1765,6 +2042,7 @@ tmResetCallback (guint data)
 		faceSetting -> swRunTime = 0;
 		faceSetting -> updateFace = true;
 		lastTime = -1;
+		tickWakeUp ();
 	}
 }
 
@@ -1947,6 +2225,24 @@ void configSaveCallback (guint data)
 	}
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  G E T  W A L L  T I M E                                                                                           *
+ *  =======================                                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Get the wall clock time, or the time of the frame being drawn when called from the frame clock.
+ *  \result Microseconds from 1970.
+ */
+static gint64 getWallTime (void)
+{
+	if (frameWallTime != -1)
+		return frameWallTime;
+
+	return g_get_real_time ();
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  G E T  S T O P W A T C H  T I M E                                                                                 *
@@ -1961,22 +2257,17 @@ void configSaveCallback (guint data)
 int
 getStopwatchTime (FACE_SETTINGS *faceSetting)
 {
-	struct timeval tv;
-
 	if (faceSetting -> swStartTime == -1)
 	{
 		return faceSetting -> swRunTime;
 	}
 	else
 	{
-		if (gettimeofday(&tv, NULL) == 0)
-		{
-			long long tempTime = (tv.tv_sec * 100) + (tv.tv_usec / 10000);
-			tempTime -= faceSetting -> swStartTime;
-			return (int)(tempTime % (30 * 60 * 100));
-		}
+		long long tempTime = getWallTime () / 10000;
+
+		tempTime -= faceSetting -> swStartTime;
+		return (int)(tempTime % (30 * 60 * 100));
 	}
-	return 0;
 }
 
 /**********************************************************************************************************************
@@ -1993,8 +2284,6 @@ getStopwatchTime (FACE_SETTINGS *faceSetting)
 int
 getTimerTime (FACE_SETTINGS *faceSetting)
 {
-	struct timeval tv;
-
 	if (faceSetting -> swStartTime == -1)
 	{
 		int retn = faceSetting -> timerInfo.totalTime - faceSetting -> swRunTime;
@@ -2002,27 +2291,107 @@ getTimerTime (FACE_SETTINGS *faceSetting)
 	}
 	else
 	{
-		if (gettimeofday(&tv, NULL) == 0)
+		long long tempTime = getWallTime () / 1000000;
+
+		tempTime -= faceSetting -> swStartTime;
+		int retn = faceSetting -> timerInfo.totalTime - tempTime;
+
+		if (retn < 0)
 		{
-			long long tempTime = tv.tv_sec;
+			faceSetting -> swRunTime = faceSetting -> timerInfo.totalTime;
+			faceSetting -> swStartTime = -1;
+			if (faceSetting -> timerInfo.totalTime > 0)
+			{
+				checkForTimer (faceSetting);
+			}
+			return 0;
+		}
+		return retn % (24 * 3600);
+	}
+}
 
-			tempTime -= faceSetting -> swStartTime;
-			int retn = faceSetting -> timerInfo.totalTime - tempTime;
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  C O M P I L E  F O R M A T                                                                                        *
+ *  ==========================                                                                                        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Turn a display string into a list of operations, done when the string is loaded.
+ *  \param stringNumber Which string.
+ *  \result None.
+ */
+static void compileFormat (int stringNumber)
+{
+	FORMAT_PROG *prog = &formatProgs[stringNumber];
+	char *format = displayString[stringNumber];
+	FORMAT_OP *op;
+	int i = 0;
 
-			if (retn < 0)
+	memset (prog, 0, sizeof (FORMAT_PROG));
+	while (format[i])
+	{
+		op = &prog -> ops[prog -> opCount];
+		if (format[i] != '%')
+		{
+			/*----------------------------------------------------------------------------------------*
+             * Join literal text into one span, added to the last span if there is one                *
+             *----------------------------------------------------------------------------------------*/
+			if (prog -> opCount && op[-1].opType == 0 && op[-1].length < 255)
 			{
-				faceSetting -> swRunTime = faceSetting -> timerInfo.totalTime;
-				faceSetting -> swStartTime = -1;
-				if (faceSetting -> timerInfo.totalTime > 0)
-				{
-					checkForTimer (faceSetting);
-				}
-				return 0;
+				++op[-1].length;
+			}
+			else
+			{
+				op -> opType = 0;
+				op -> offset = i;
+				op -> length = 1;
+				++prog -> opCount;
 			}
-			return retn % (24 * 3600);
+			++i;
+			continue;
+		}
+
+		/*--------------------------------------------------------------------------------------------*
+         * A field, strftime ones may have a - or _ flag                                              *
+         *--------------------------------------------------------------------------------------------*/
+		op -> command[0] = '%';
+		op -> command[1] = 0;
+		if (format[++i] == '-' || format[i] == '_')
+		{
+			op -> command[1] = format[i];
+			while (format[i] == '-' || format[i] == '_')
+				++i;
+		}
+		if (format[i] == 0)
+			break;
+
+		switch (format[i])
+		{
+		case '*':
+		case '#':
+		case '@':
+			op -> opType = format[i];
+			break;
+
+		case '&':
+		case '$':
+			op -> opType = format[i];
+			prog -> noCache = 1;
+			break;
+
+		default:
+			op -> opType = '%';
+			op -> command[op -> command[1] ? 2 : 1] = format[i];
+			if (strchr ("crsSTX+", format[i]))
+				prog -> useSeconds = 1;
+			break;
 		}
+		++prog -> opCount;
+		++i;
 	}
-	return 0;
+	prog -> compiled = 1;
+	++formatGeneration;
 }
 
 /**********************************************************************************************************************
@@ -2043,106 +2412,143 @@ getTimerTime (FACE_SETTINGS *faceSetting)
 char *getStringValue (char *addBuffer, int maxSize, int stringNumber, int face, time_t timeNow)
 {
 	FACE_SETTINGS *faceSetting = clockInst.faceSettings[face];
-	char tempAddStr[101], tempCommand[11], stringFormat[81];
-	int i = 0, j = 0;
+	FORMAT_PROG *prog = &formatProgs[stringNumber];
+	FORMAT_CACHE *cache = NULL;
+	char tempAddStr[101];
+	int i, len = 0, keyTime[8];
 	struct tm tm;
 
-	localtime_r (&timeNow, &tm);
-	tempCommand[0] = tempAddStr[0] = addBuffer[0] = 0;
-	strcpy (stringFormat, displayString[stringNumber]);
+	if (!prog -> compiled)
+	{
+		compileFormat (stringNumber);
+	}
+	if (!getFaceLocalTime (faceSetting, timeNow, &tm))
+	{
+		localtime_r (&timeNow, &tm);
+	}
+	addBuffer[0] = 0;
 
-	while (stringFormat[i])
+	/*------------------------------------------------------------------------------------------------*
+     * Reuse the last result if the time it shows and the zone have not changed                       *
+     *------------------------------------------------------------------------------------------------*/
+	if (!prog -> noCache && maxSize <= 201)
 	{
-		if (tempCommand[0] == '%')
+		if (faceSetting -> formatCache == NULL)
 		{
-			tempCommand[j] = stringFormat[i];
-			tempCommand[j + 1] = 0;
-
-			switch (tempCommand[j])
-			{
-			case '-':
-			case '_':
-				j = 2;
-				break;
-			case '*':				/* Timezone's city un-wrapped */
+			faceSetting -> formatCache = calloc (TXT_COUNT, sizeof (FORMAT_CACHE));
+		}
+		if ((cache = (FORMAT_CACHE *)faceSetting -> formatCache) != NULL)
+		{
+			cache = &cache[stringNumber];
+			keyTime[0] = prog -> useSeconds ? tm.tm_sec : -1;
+			keyTime[1] = tm.tm_min;
+			keyTime[2] = tm.tm_hour;
+			keyTime[3] = tm.tm_mday;
+			keyTime[4] = tm.tm_mon;
+			keyTime[5] = tm.tm_year;
+			keyTime[6] = (int)tm.tm_gmtoff;
+			keyTime[7] = tm.tm_isdst;
+
+			if (cache -> generation == formatGeneration && cache -> maxSize == maxSize &&
+					cache -> currentTZ == faceSetting -> currentTZ && cache -> keyZone == tm.tm_zone &&
+					!memcmp (cache -> keyTime, keyTime, sizeof (keyTime)))
 			{
-				int k = 0;
-				char *text = faceSetting -> overwriteMesg[0] ?
-					faceSetting -> overwriteMesg : faceSetting -> currentTZDisp;
-
-				while (text[k])
-				{
-					tempAddStr[k] = (text[k] == '\n' ? ' ' : text[k]);
-					tempAddStr[++k] = 0;
-				}
-				tempCommand[j = 0] = 0;
-				break;
+				strcpy (addBuffer, cache -> output);
+				return addBuffer;
 			}
-			case '#':				/* Timezone's city wrapped */
-				strncpy (tempAddStr, (faceSetting -> overwriteMesg[0] ? faceSetting -> overwriteMesg :
-						faceSetting -> currentTZDisp), 100);
-				tempCommand[j = 0] = 0;
-				break;
-			case '@':				/* Timezone's area */
-				strcpy (tempAddStr, faceSetting -> currentTZArea);
-				tempCommand[j = 0] = 0;
-				break;
-			case '&':
+		}
+	}
+
+	for (i = 0; i < prog -> opCount; ++i)
+	{
+		FORMAT_OP *op = &prog -> ops[i];
+
+		tempAddStr[0] = 0;
+		switch (op -> opType)
+		{
+		case 0:					/* Literal text, as much as fits */
+		{
+			int copy = op -> length;
+
+			if (copy > maxSize - 1 - len)
+				copy = maxSize - 1 - len;
+			if (copy > 0)
 			{
-				if (faceSetting -> stopwatch)
-				{
-					int swTime = getStopwatchTime (faceSetting);
-					sprintf (tempAddStr, "%d:%02d:%02d.%02d",
-							swTime / 360000, (swTime / 6000) % 60, (swTime / 100) % 60, swTime % 100);
-				}
-				else if (faceSetting -> timer)
-				{
-					int cdTime = getTimerTime (faceSetting);
-					sprintf (tempAddStr, "%d:%02d:%02d",
-							cdTime / 3600, (cdTime / 60) % 60, cdTime % 60);
-				}
-				else
-				{
-					strcpy (tempAddStr, _("not set"));
-				}
-				tempCommand[j = 0] = 0;
-				break;
+				memcpy (&addBuffer[len], &displayString[stringNumber][op -> offset], copy);
+				addBuffer[len += copy] = 0;
 			}
-			case '$':
-				if (faceSetting -> alarm)
-					sprintf (tempAddStr, "%d:%02d", faceSetting -> alarmInfo.alarmHour, faceSetting -> alarmInfo.alarmMin);
-				else
-					strcpy (tempAddStr, _("not set"));
-				tempCommand[j = 0] = 0;
-				break;
-			default:
-				strftime (tempAddStr, 80, tempCommand, &tm);
-				tempCommand[j = 0] = 0;
-				break;
+			continue;
+		}
+		case '*':				/* Timezone's city un-wrapped */
+		{
+			int k = 0;
+			char *text = faceSetting -> overwriteMesg[0] ?
+				faceSetting -> overwriteMesg : faceSetting -> currentTZDisp;
+
+			while (text[k])
+			{
+				tempAddStr[k] = (text[k] == '\n' ? ' ' : text[k]);
+				tempAddStr[++k] = 0;
 			}
+			break;
 		}
-		else
+		case '#':				/* Timezone's city wrapped */
+			strncpy (tempAddStr, (faceSetting -> overwriteMesg[0] ? faceSetting -> overwriteMesg :
+					faceSetting -> currentTZDisp), 100);
+			break;
+		case '@':				/* Timezone's area */
+			strcpy (tempAddStr, faceSetting -> currentTZArea);
+			break;
+		case '&':
 		{
-			if (stringFormat[i] == '%')
+			if (faceSetting -> stopwatch)
 			{
-				tempCommand[0] = '%';
-				tempCommand[j = 1] = 0;
+				int swTime = getStopwatchTime (faceSetting);
+				sprintf (tempAddStr, "%d:%02d:%02d.%02d",
+						swTime / 360000, (swTime / 6000) % 60, (swTime / 100) % 60, swTime % 100);
+			}
+			else if (faceSetting -> timer)
+			{
+				int cdTime = getTimerTime (faceSetting);
+				sprintf (tempAddStr, "%d:%02d:%02d",
+						cdTime / 3600, (cdTime / 60) % 60, cdTime % 60);
 			}
 			else
 			{
-				tempAddStr[0] = stringFormat[i];
-				tempAddStr[1] = 0;
+				strcpy (tempAddStr, _("not set"));
 			}
+			break;
+		}
+		case '$':
+			if (faceSetting -> alarm)
+				sprintf (tempAddStr, "%d:%02d", faceSetting -> alarmInfo.alarmHour, faceSetting -> alarmInfo.alarmMin);
+			else
+				strcpy (tempAddStr, _("not set"));
+			break;
+		default:
+			strftime (tempAddStr, 80, op -> command, &tm);
+			break;
 		}
 		if (tempAddStr[0])
 		{
-			if (strlen (tempAddStr) + strlen (addBuffer) < maxSize)
+			int addLen = strlen (tempAddStr);
+
+			if (addLen + len < maxSize)
 			{
-				strcat (addBuffer, tempAddStr);
+				strcpy (&addBuffer[len], tempAddStr);
+				len += addLen;
 			}
-			tempAddStr[0] = 0;
 		}
-		i++;
+	}
+
+	if (cache != NULL)
+	{
+		strcpy (cache -> output, addBuffer);
+		memcpy (cache -> keyTime, keyTime, sizeof (keyTime));
+		cache -> keyZone = tm.tm_zone;
+		cache -> currentTZ = faceSetting -> currentTZ;
+		cache -> maxSize = maxSize;
+		cache -> generation = formatGeneration;
 	}
 	return addBuffer;
 }
@@ -2218,6 +2624,56 @@ void execCommand (char *command, char *message)
 	execv (args[0], args);
 }
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  G E T  F A C E  L O C A L  T I M E                                                                                *
+ *  ==================================                                                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Convert a time for a face, reusing the face's local day until midnight or the next change.
+ *  \param faceSetting Face settings.
+ *  \param t The time in secs from 1970.
+ *  \param tm Put the time here.
+ *  \result 1 if converted, 0 if the zone could not be read.
+ */
+static int getFaceLocalTime (FACE_SETTINGS *faceSetting, time_t t, struct tm *tm)
+{
+	int secs;
+	time_t nextChange;
+
+	if (faceSetting -> zoneCacheTZ != faceSetting -> currentTZ || t < faceSetting -> zoneFrom ||
+			t >= faceSetting -> zoneUntil)
+	{
+		if (!zoneLocalTime (&timeZones[faceSetting -> currentTZ], t, &faceSetting -> zoneDay, &nextChange))
+		{
+			faceSetting -> zoneUntil = 0;
+			return 0;
+		}
+		secs = (faceSetting -> zoneDay.tm_hour * 3600) + (faceSetting -> zoneDay.tm_min * 60) +
+				faceSetting -> zoneDay.tm_sec;
+
+		faceSetting -> zoneCacheTZ = faceSetting -> currentTZ;
+		faceSetting -> zoneFrom = t;
+		faceSetting -> zoneDayStart = t - secs;
+		faceSetting -> zoneUntil = faceSetting -> zoneDayStart + 86400;
+		if (nextChange < faceSetting -> zoneUntil)
+		{
+			faceSetting -> zoneUntil = nextChange;
+		}
+	}
+
+	/*------------------------------------------------------------------------------------------------*
+     * Same offset and same local day, only the time of day moves on.                                 *
+     *------------------------------------------------------------------------------------------------*/
+	secs = (int)(t - faceSetting -> zoneDayStart);
+	*tm = faceSetting -> zoneDay;
+	tm -> tm_hour = secs / 3600;
+	tm -> tm_min = (secs / 60) % 60;
+	tm -> tm_sec = secs % 60;
+	return 1;
+}
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  *  G E T  T H E  F A C E  T I M E                                                                                    *
@@ -2233,20 +2689,31 @@ void execCommand (char *command, char *message)
  */
 void getTheFaceTime (FACE_SETTINGS *faceSetting, time_t *t, struct tm *tm)
 {
-	int timeZone = faceSetting -> currentTZ;
+	TZ_INFO *timeZone = &timeZones[faceSetting -> currentTZ];
 
-	if (timeZones[timeZone].value == 0)
+	if (timeZone -> value != 0 && timeZone -> value < FIRST_CITY)
+	{
+		*t += 3600 * (timeZone -> value - GMT_ZERO);
+	}
+
+	/*------------------------------------------------------------------------------------------------*
+     * The zone file is only read once, fall back to setting TZ if it could not be used.              *
+     *------------------------------------------------------------------------------------------------*/
+	if (getFaceLocalTime (faceSetting, *t, tm))
+	{
+		return;
+	}
+	if (timeZone -> value == 0)
 	{
 		unsetenv ("TZ");
 	}
-	else if (timeZones[timeZone].value < FIRST_CITY)
+	else if (timeZone -> value < FIRST_CITY)
 	{
 		setenv ("TZ", "GMT", 1);
-		*t += 3600 * (timeZones[timeZone].value - GMT_ZERO);
 	}
 	else
 	{
-		setenv ("TZ", timeZones[timeZone].envName, 1);
+		setenv ("TZ", timeZone -> envName, 1);
 	}
 	tzset ();
 	localtime_r (t, tm);
@@ -2426,6 +2893,7 @@ void loadDateFormat (char *newFormat)
 					foundStr[j] = 0;
 				}
 				strcpy (displayString[format], foundStr);
+				compileFormat (format);
 				sprintf (value, "text_format_%s", nameFormats[format]);
 				configSetValue (value, displayString[format]);
 				return;
@@ -2557,6 +3025,7 @@ void loadTimerInfo (int face, char *buff)
 			faceSetting -> swRunTime = 0;
 			faceSetting -> updateFace = true;
 			lastTime = -1;
+			tickWakeUp ();
 		}
 	}
 	sprintf (value, "timer_%d", face + 1);
@@ -2942,6 +3411,7 @@ void updateClock (void)
 	configSetIntValue ("marker_scale", clockInst.dialConfig.markerScale);
 	configSetValue ("font_name", clockInst.fontName);
 	lastTime = -1;
+	tickWakeUp ();
 }
 
 /**********************************************************************************************************************
@@ -3000,6 +3470,7 @@ void loadConfig (int *posX, int *posY)
 	{
 		sprintf (value, "text_format_%s", nameFormats[i]);
 		configGetValue (value, displayString[i], 100);
+		compileFormat (i);
 	}
 	for (i = 0; i < HAND_COUNT; i++)
 	{
@@ -3205,7 +3676,7 @@ main (int argc, char *argv[])
 	* OK all ready lets run it!                                                                      *
 	*------------------------------------------------------------------------------------------------*/
 	gtk_widget_show_all (GTK_WIDGET (clockInst.dialConfig.mainWindow));
-	g_timeout_add (50, clockTickCallback, NULL);
+	tickWakeUp ();
 	dialSetOpacity ();
 
 	/*------------------------------------------------------------------------------------------------*
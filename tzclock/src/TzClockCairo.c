@@ -71,40 +71,10 @@ drawFace (cairo_t *cr, int face, int posX, int posY, char circ)
      *------------------------------------------------------------------------------------------------*/
 	getTheFaceTime (faceSetting, &t, &tm);
 
-	/*------------------------------------------------------------------------------------------------*
-     * Draw the face, it is made up of 3 overlapping circles                                          *
-     *------------------------------------------------------------------------------------------------*/
-	dialDrawStart (cr, posX, posY);
-
 	col = (clockInst.weHaveFocus && face == clockInst.currentFace) ? FACE3_COLOUR : FACE4_COLOUR;
-	if (circ)
-	{
-		dialCircleGradient (64, col, 1);
-	}
-	else
-	{
-		dialSquareGradient (64, col, 1);
-	}
-	dialCircleGradient (62, FACE2_COLOUR, 0);
-	dialCircleGradient (58, FACE1_COLOUR, 1);
-
-	/*------------------------------------------------------------------------------------------------*
-     * Add the text, ether the date or the timezone, plus an AM/PM indicator                          *
-     *------------------------------------------------------------------------------------------------*/
 	showSubSec = (faceSetting -> showTime && faceSetting -> showSeconds && (faceSetting -> stopwatch || faceSetting -> timer ||
 			faceSetting -> subSecond)) ? 1 : 0;
 
-	getStringValue (tempString, 100, faceSetting -> stopwatch || faceSetting -> timer ?
-			(timeZone ? TXT_TOPSW_Z : TXT_TOPSW_L) : (timeZone ? TXT_TOP_Z : TXT_TOP_L), face, t);
-	dialDrawText (0, tempString, TEXT__COLOUR);
-
-	if (!showSubSec)
-	{
-		getStringValue (tempString, 100, faceSetting -> stopwatch || faceSetting -> timer ?
-			(timeZone ? TXT_BOTTOMSW_Z : TXT_BOTTOMSW_L) : timeZone ? TXT_BOTTOM_Z : TXT_BOTTOM_L, face, t);
-		dialDrawText (1, tempString, TEXT__COLOUR);
-	}
-
 	/*------------------------------------------------------------------------------------------------*
      * Calculate which markers to draw                                                                *
      *------------------------------------------------------------------------------------------------*/
@@ -141,102 +111,141 @@ drawFace (cairo_t *cr, int face, int posX, int posY, char circ)
 	}
 
 	/*------------------------------------------------------------------------------------------------*
-     * Draw the hour markers                                                                          *
+     * Only the hands and text change every tick, the rest of the face is kept in a cache             *
      *------------------------------------------------------------------------------------------------*/
-	j = faceSetting -> show24Hour ? 120 : 60;
-	for (i = 0; i < j ; i++)
+	sprintf (tempString, "%d:%d:%d:%d:%d:%X", col, faceSetting -> show24Hour, showSubSec, faceSetting -> stopwatch,
+			faceSetting -> timer, markerFlags);
+
+	if (!dialDrawStartCached (cr, posX, posY, circ ? -1 : face, tempString))
 	{
-		int m = faceSetting -> show24Hour ? i * 10 : i * 20;
+		/*--------------------------------------------------------------------------------------------*
+         * Draw the face, it is made up of 3 overlapping circles                                      *
+         *--------------------------------------------------------------------------------------------*/
+		if (circ)
+		{
+			dialCircleGradient (64, col, 1);
+		}
+		else
+		{
+			dialSquareGradient (64, col, 1);
+		}
+		dialCircleGradient (62, FACE2_COLOUR, 0);
+		dialCircleGradient (58, FACE1_COLOUR, 1);
 
-		if (clockInst.dialConfig.dialSize > 256)
+		/*--------------------------------------------------------------------------------------------*
+         * Draw the hour markers                                                                      *
+         *--------------------------------------------------------------------------------------------*/
+		j = faceSetting -> show24Hour ? 120 : 60;
+		for (i = 0; i < j ; i++)
+		{
+			int m = faceSetting -> show24Hour ? i * 10 : i * 20;
+
+			if (clockInst.dialConfig.dialSize > 256)
+			{
+				if (!faceSetting -> show24Hour || !(i % 2))
+					dialDrawMinute (30, 1, m, MMARK_COLOUR);
+			}
+			if (!(i % 5))
+			{
+				dialDrawMinute (29, 1, m, HMARK_COLOUR);
+				if (markerFlags & (1 << (i / 5)))
+				{
+					char buff[11] = "";
+					int hour = (i == 0 ? (faceSetting -> show24Hour ? 24 : 12) : i / 5);
+					if (clockInst.dialConfig.markerType == 3)
+						sprintf (buff, "%d", hour);
+					if (clockInst.dialConfig.markerType == 4)
+						strcpy (buff, roman[hour]);
+					dialDrawMark (m, 31, QFILL_COLOUR, QMARK_COLOUR, buff);
+				}
+			}
+		}
+
+		/*--------------------------------------------------------------------------------------------*
+         * Draw other clock faces                                                                     *
+         *--------------------------------------------------------------------------------------------*/
+		if (showSubSec)
+		{
+			dialCircleGradientX (centerX, posY + ((3 * clockInst.dialConfig.dialSize) >> 2), 21, FACE2_COLOUR, 1);
+			dialDrawCircleX (centerX, posY + ((3 * clockInst.dialConfig.dialSize) >> 2), 19, FACE5_COLOUR, -1);
+		}
+		if (faceSetting -> stopwatch || faceSetting -> timer)
 		{
-			if (!faceSetting -> show24Hour || !(i % 2))
-				dialDrawMinute (30, 1, m, MMARK_COLOUR);
+			dialCircleGradientX (posX + (clockInst.dialConfig.dialSize >> 2), centerY, 21, FACE2_COLOUR, 1);
+			dialDrawCircleX (posX + (clockInst.dialConfig.dialSize >> 2), centerY, 19, FACE5_COLOUR, -1);
+			dialCircleGradientX (posX + (3 * clockInst.dialConfig.dialSize >> 2), centerY, 21, FACE2_COLOUR, 1);
+			dialDrawCircleX (posX + (3 * clockInst.dialConfig.dialSize >> 2), centerY, 19, FACE5_COLOUR, -1);
 		}
-		if (!(i % 5))
+
+		if (showSubSec || faceSetting -> stopwatch || faceSetting -> timer)
 		{
-			dialDrawMinute (29, 1, m, HMARK_COLOUR);
-			if (markerFlags & (1 << (i / 5)))
+			for (i = 0; i < 60 ; i++)
 			{
-				char buff[11] = "";
-				int hour = (i == 0 ? (faceSetting -> show24Hour ? 24 : 12) : i / 5);
-				if (clockInst.dialConfig.markerType == 3)
-					sprintf (buff, "%d", hour);
-				if (clockInst.dialConfig.markerType == 4)
-					strcpy (buff, roman[hour]);
-				dialDrawMark (m, 31, QFILL_COLOUR, QMARK_COLOUR, buff);
+				int m = i * 20;
+
+				if (showSubSec)
+				{
+					if (!(i % 5))
+						dialDrawMinuteX (centerX, posY + ((3 * clockInst.dialConfig.dialSize) >> 2),
+								(i % 15) ? 9 : 8, (i % 15) ? 1 : 2, m, WMARK_COLOUR);
+				}
+				if (faceSetting -> stopwatch)
+				{
+					if (!(i % 3))
+						dialDrawMinuteX (posX + (clockInst.dialConfig.dialSize >> 2), centerY,
+								(i % 6) ? 9 : 8, (i % 6) ? 1 : 2, m, WMARK_COLOUR);
+					if (!(i % 2))
+						dialDrawMinuteX (posX + ((3 * clockInst.dialConfig.dialSize) >> 2), centerY,
+								(i % 10) ? 9 : 8, (i % 10) ? 1 : 2, m, WMARK_COLOUR);
+				}
+				else if (faceSetting -> timer)
+				{
+					if (!(i % 5))
+						dialDrawMinuteX (posX + (clockInst.dialConfig.dialSize >> 2), centerY,
+								(i % 10) ? 9 : 8, (i % 10) ? 1 : 2, m, WMARK_COLOUR);
+					if (!(i % 2))
+						dialDrawMinuteX (posX + ((3 * clockInst.dialConfig.dialSize) >> 2), centerY,
+								(i % 10) ? 9 : 8, (i % 10) ? 1 : 2, m, WMARK_COLOUR);
+				}
 			}
 		}
+		dialDrawCacheDone ();
 	}
 
 	/*------------------------------------------------------------------------------------------------*
-     * Draw other clock faces                                                                         *
+     * Add the text, ether the date or the timezone, plus an AM/PM indicator                          *
      *------------------------------------------------------------------------------------------------*/
-	if (showSubSec)
-	{
-		dialCircleGradientX (centerX, posY + ((3 * clockInst.dialConfig.dialSize) >> 2), 21, FACE2_COLOUR, 1);
-		dialDrawCircleX (centerX, posY + ((3 * clockInst.dialConfig.dialSize) >> 2), 19, FACE5_COLOUR, -1);
-	}
-	if (faceSetting -> stopwatch || faceSetting -> timer)
+	getStringValue (tempString, 100, faceSetting -> stopwatch || faceSetting -> timer ?
+			(timeZone ? TXT_TOPSW_Z : TXT_TOPSW_L) : (timeZone ? TXT_TOP_Z : TXT_TOP_L), face, t);
+	dialDrawText (0, tempString, TEXT__COLOUR);
+
+	if (!showSubSec)
 	{
-		dialCircleGradientX (posX + (clockInst.dialConfig.dialSize >> 2), centerY, 21, FACE2_COLOUR, 1);
-		dialDrawCircleX (posX + (clockInst.dialConfig.dialSize >> 2), centerY, 19, FACE5_COLOUR, -1);
-		dialCircleGradientX (posX + (3 * clockInst.dialConfig.dialSize >> 2), centerY, 21, FACE2_COLOUR, 1);
-		dialDrawCircleX (posX + (3 * clockInst.dialConfig.dialSize >> 2), centerY, 19, FACE5_COLOUR, -1);
+		getStringValue (tempString, 100, faceSetting -> stopwatch || faceSetting -> timer ?
+			(timeZone ? TXT_BOTTOMSW_Z : TXT_BOTTOMSW_L) : timeZone ? TXT_BOTTOM_Z : TXT_BOTTOM_L, face, t);
+		dialDrawText (1, tempString, TEXT__COLOUR);
 	}
 
-	if (showSubSec || faceSetting -> stopwatch || faceSetting -> timer)
+	if ((showSubSec || faceSetting -> stopwatch || faceSetting -> timer) && clockInst.showSubText)
 	{
-		for (i = 0; i < 60 ; i++)
+		if (faceSetting -> stopwatch)
 		{
-			int m = i * 20;
-
-			if (showSubSec)
-			{
-				if (!(i % 5))
-					dialDrawMinuteX (centerX, posY + ((3 * clockInst.dialConfig.dialSize) >> 2),
-							(i % 15) ? 9 : 8, (i % 15) ? 1 : 2, m, WMARK_COLOUR);
-			}
-			if (faceSetting -> stopwatch)
-			{
-				if (!(i % 3))
-					dialDrawMinuteX (posX + (clockInst.dialConfig.dialSize >> 2), centerY,
-							(i % 6) ? 9 : 8, (i % 6) ? 1 : 2, m, WMARK_COLOUR);
-				if (!(i % 2))
-					dialDrawMinuteX (posX + ((3 * clockInst.dialConfig.dialSize) >> 2), centerY,
-							(i % 10) ? 9 : 8, (i % 10) ? 1 : 2, m, WMARK_COLOUR);
-			}
-			else if (faceSetting -> timer)
-			{
-				if (!(i % 5))
-					dialDrawMinuteX (posX + (clockInst.dialConfig.dialSize >> 2), centerY,
-							(i % 10) ? 9 : 8, (i % 10) ? 1 : 2, m, WMARK_COLOUR);
-				if (!(i % 2))
-					dialDrawMinuteX (posX + ((3 * clockInst.dialConfig.dialSize) >> 2), centerY,
-							(i % 10) ? 9 : 8, (i % 10) ? 1 : 2, m, WMARK_COLOUR);
-			}
+			getStringValue (tempString, 100, TXT_SUBSW_LT, face, t);
+			dialDrawTextS (2, tempString, TEXT__COLOUR, 6);
+			getStringValue (tempString, 100, TXT_SUBSW_RT, face, t);
+			dialDrawTextS (3, tempString, TEXT__COLOUR, 6);
 		}
-		if (clockInst.showSubText)
+		else if (faceSetting -> timer)
 		{
-			if (faceSetting -> stopwatch)
-			{
-				getStringValue (tempString, 100, TXT_SUBSW_LT, face, t);
-				dialDrawTextS (2, tempString, TEXT__COLOUR, 6);
-				getStringValue (tempString, 100, TXT_SUBSW_RT, face, t);
-				dialDrawTextS (3, tempString, TEXT__COLOUR, 6);
-			}
-			else if (faceSetting -> timer)
-			{
-				getStringValue (tempString, 100, TXT_SUBTM_LT, face, t);
-				dialDrawTextS (2, tempString, TEXT__COLOUR, 6);
-				getStringValue (tempString, 100, TXT_SUBTM_RT, face, t);
-				dialDrawTextS (3, tempString, TEXT__COLOUR, 6);
-			}
-			if (showSubSec)
-			{
-				getStringValue (tempString, 100, TXT_SUBSC_BT, face, t);
-				dialDrawTextS (4, tempString, TEXT__COLOUR, 6);
-			}
+			getStringValue (tempString, 100, TXT_SUBTM_LT, face, t);
+			dialDrawTextS (2, tempString, TEXT__COLOUR, 6);
+			getStringValue (tempString, 100, TXT_SUBTM_RT, face, t);
+			dialDrawTextS (3, tempString, TEXT__COLOUR, 6);
+		}
+		if (showSubSec)
+		{
+			getStringValue (tempString, 100, TXT_SUBSC_BT, face, t);
+			dialDrawTextS (4, tempString, TEXT__COLOUR, 6);
 		}
 	}
 
@@ -302,13 +311,23 @@ drawFace (cairo_t *cr, int face, int posX, int posY, char circ)
  */
 void clockExpose (cairo_t *cr)
 {
-	int i, j, face = 0;
+	int i, j, face = 0, dialSize = clockInst.dialConfig.dialSize;
+	double clipX1, clipY1, clipX2, clipY2;
+
+	/*------------------------------------------------------------------------------------------------*
+     * Skip any faces that are outside the area being redrawn                                         *
+     *------------------------------------------------------------------------------------------------*/
+	cairo_clip_extents (cr, &clipX1, &clipY1, &clipX2, &clipY2);
 
 	for (j = 0; j < clockInst.dialConfig.dialHeight; j++)
 	{
 		for (i = 0; i < clockInst.dialConfig.dialWidth; i++)
 		{
-			drawFace (cr, face++, (i * clockInst.dialConfig.dialSize), (j * clockInst.dialConfig.dialSize), 0);
+			if ((i + 1) * dialSize > clipX1 && i * dialSize < clipX2 && (j + 1) * dialSize > clipY1 && j * dialSize < clipY2)
+			{
+				drawFace (cr, face, (i * dialSize), (j * dialSize), 0);
+			}
+			++face;
 		}
 	}
 }
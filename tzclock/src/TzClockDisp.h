@@ -214,6 +214,13 @@ typedef struct _faceSettings
 	GtkWidget *drawingArea, *eventBox;
 	ALARM_TIME alarmInfo;
 	TIMER_INFO timerInfo;
+	int zoneCacheTZ;			/* Local day cached for this zone */
+	time_t zoneFrom;			/* Cache holds from here */
+	time_t zoneUntil;			/* ...to the next change or midnight */
+	time_t zoneDayStart;
+	struct tm zoneDay;
+	gint64 nextTick;			/* Monotonic ms when a hand next moves */
+	void *formatCache;			/* Last display strings made */
 }
 FACE_SETTINGS;
 
@@ -248,6 +255,8 @@ typedef struct _tzInfo
 {
 	char *envName;
 	int value;
+	int zoneLoaded;
+	void *zoneData;
 }
 TZ_INFO;
 
@@ -262,4 +271,6 @@ char *getStringValue (char *addBuffer, int maxSize, int stringNumber, int face,
 int	 xSinCos (int number, int angle, int useCos);
 int	 getStopwatchTime (FACE_SETTINGS *faceSetting);
 int	 getTimerTime (FACE_SETTINGS *faceSetting);
+void tickWakeUp (void);
+int	 zoneLocalTime (TZ_INFO *timeZone, time_t t, struct tm *tm, time_t *nextChange);
 
@@ -0,0 +1,764 @@
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  T Z  C L O C K  Z O N E . C                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ *  Copyright (c) 2023 Chris Knight                                                                                   *
+ *                                                                                                                    *
+ *  File TzClockZone.c part of TzClock is free software: you can redistribute it and/or modify it under the terms     *
+ *  of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License,  *
+ *  or (at your option) any later version.                                                                            *
+ *                                                                                                                    *
+ *  TzClock is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied     *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more     *
+ *  details.                                                                                                          *
+ *                                                                                                                    *
+ *  You should have received a copy of the GNU General Public License along with this program. If not, see:           *
+ *  <http://www.gnu.org/licenses/>                                                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \file
+ *  \brief Read the TZif zone files once and convert times without touching TZ.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "TzClockDisp.h"
+#include "ParseZone.h"
+
+#define MAX_ZONE_FILE	(1024 * 1024)
+#define MAX_ZONE_COUNT	65536
+#define SECS_PER_DAY	86400
+
+/*----------------------------------------------------------------------------------------------------*
+ * One local time type, the abbreviation points into the zone's own strings.                          *
+ *----------------------------------------------------------------------------------------------------*/
+typedef struct _zoneType
+{
+	int gmtOffset;
+	int isDst;
+	char *abbr;
+}
+ZONE_TYPE;
+
+/*----------------------------------------------------------------------------------------------------*
+ * A POSIX TZ rule, type is 'J' (1-365 no leap day), 'D' (0-365) or 'M' (month.week.day).             *
+ *----------------------------------------------------------------------------------------------------*/
+typedef struct _zoneRule
+{
+	int type;
+	int day;
+	int week;
+	int month;
+	int secs;
+}
+ZONE_RULE;
+
+/*----------------------------------------------------------------------------------------------------*
+ * A parsed zone, the tables follow the structure in the same allocation.                             *
+ *----------------------------------------------------------------------------------------------------*/
+typedef struct _zoneData
+{
+	int transCount;
+	int typeCount;
+	long long *transTimes;
+	unsigned char *transTypes;
+	ZONE_TYPE *types;
+	int hasFooter;
+	int footerDst;
+	ZONE_TYPE footerTypes[2];
+	ZONE_RULE footerRules[2];
+	char footerNames[2][32];
+}
+ZONE_DATA;
+
+static ZONE_TYPE gmtType = { 0, 0, "GMT" };
+static ZONE_DATA gmtZone = { .transCount = 0, .typeCount = 1, .types = &gmtType };
+static char *localZoneFile = "/etc/localtime";
+static char *defaultRules = "M3.2.0,M11.1.0";
+static int monthDays[2][12] =
+{
+	{ 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 },
+	{ 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 }
+};
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  I S  L E A P                                                                                             *
+ *  =====================                                                                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Is this a leap year.
+ *  \param year Full year number.
+ *  \result 1 if it is a leap year.
+ */
+static int zoneIsLeap (long long year)
+{
+	return (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) ? 1 : 0;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  D A Y S  F R O M  C I V I L                                                                              *
+ *  ====================================                                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Count the days from 1970 to a date.
+ *  \param year Full year number.
+ *  \param month Month 1 to 12.
+ *  \param day Day of the month 1 to 31.
+ *  \result Days since 1 Jan 1970, negative before.
+ */
+static long long zoneDaysFromCivil (long long year, int month, int day)
+{
+	long long era, yearOfEra, dayOfYear, dayOfEra;
+
+	year -= (month <= 2);
+	era = (year >= 0 ? year : year - 399) / 400;
+	yearOfEra = year - era * 400;
+	dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+	dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+	return era * 146097 + dayOfEra - 719468;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  C I V I L  F R O M  D A Y S                                                                              *
+ *  ====================================                                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Convert days from 1970 to a date.
+ *  \param days Days since 1 Jan 1970.
+ *  \param year Return the full year number.
+ *  \param month Return the month 1 to 12.
+ *  \param day Return the day of the month 1 to 31.
+ *  \result None.
+ */
+static void zoneCivilFromDays (long long days, long long *year, int *month, int *day)
+{
+	long long era, dayOfEra, yearOfEra, dayOfYear, monthPos;
+
+	days += 719468;
+	era = (days >= 0 ? days : days - 146096) / 146097;
+	dayOfEra = days - era * 146097;
+	yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+	dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+	monthPos = (5 * dayOfYear + 2) / 153;
+	*day = (int)(dayOfYear - (153 * monthPos + 2) / 5 + 1);
+	*month = (int)(monthPos < 10 ? monthPos + 3 : monthPos - 9);
+	*year = yearOfEra + era * 400 + (*month <= 2);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  F L O O R  D I V                                                                                         *
+ *  =========================                                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Divide rounding down, so times before 1970 land on the right day.
+ *  \param value Value to divide.
+ *  \param by Divide by this, must be positive.
+ *  \result The rounded down result.
+ */
+static long long zoneFloorDiv (long long value, long long by)
+{
+	long long result = value / by;
+
+	if (value % by < 0)
+		--result;
+	return result;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  G E T  N U M B E R                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read a big endian signed number from the file.
+ *  \param buffer Where to read from.
+ *  \param size Size of the number, 4 or 8 bytes.
+ *  \result The number read.
+ */
+static long long zoneGetNumber (unsigned char *buffer, int size)
+{
+	unsigned long long value = 0;
+	int i;
+
+	for (i = 0; i < size; ++i)
+		value = (value << 8) | buffer[i];
+
+	if (size == 4)
+		return (long long)(int)(unsigned int)value;
+	return (long long)value;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  P A R S E  N A M E                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read a zone name from a POSIX TZ string, either letters or quoted in angle brackets.
+ *  \param posix Pointer to the string, moved past the name.
+ *  \param name Save the name here.
+ *  \param size Size of the name buffer.
+ *  \result 1 if a name was found.
+ */
+static int zoneParseName (char **posix, char *name, int size)
+{
+	char *p = *posix;
+	int len = 0;
+
+	if (*p == '<')
+	{
+		++p;
+		while (*p && *p != '>')
+		{
+			if (len < size - 1)
+				name[len++] = *p;
+			++p;
+		}
+		if (*p != '>')
+			return 0;
+		++p;
+	}
+	else
+	{
+		while ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z'))
+		{
+			if (len < size - 1)
+				name[len++] = *p;
+			++p;
+		}
+	}
+	name[len] = 0;
+	*posix = p;
+	return len >= 3;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  P A R S E  T I M E                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read [+-]hh[:mm[:ss]] from a POSIX TZ string.
+ *  \param posix Pointer to the string, moved past the time.
+ *  \param secs Save the signed number of seconds here.
+ *  \result 1 if a time was found.
+ */
+static int zoneParseTime (char **posix, int *secs)
+{
+	char *p = *posix;
+	int sign = 1, part = 0, value = 0, total = 0;
+
+	if (*p == '+' || *p == '-')
+	{
+		sign = (*p == '-' ? -1 : 1);
+		++p;
+	}
+	if (*p < '0' || *p > '9')
+		return 0;
+
+	while (part < 3)
+	{
+		value = 0;
+		while (*p >= '0' && *p <= '9')
+			value = (value * 10) + (*p++ - '0');
+		total = (total * 60) + value;
+		++part;
+		if (*p != ':' || p[1] < '0' || p[1] > '9')
+			break;
+		++p;
+	}
+	while (part++ < 3)
+		total *= 60;
+
+	*secs = sign * total;
+	*posix = p;
+	return 1;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  P A R S E  R U L E                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read one change rule from a POSIX TZ string, Jn, n or Mm.w.d with an optional /time.
+ *  \param posix Pointer to the string, moved past the rule.
+ *  \param rule Save the rule here.
+ *  \result 1 if a rule was found.
+ */
+static int zoneParseRule (char **posix, ZONE_RULE *rule)
+{
+	char *p = *posix;
+	int value = 0;
+
+	rule -> type = 'D';
+	rule -> secs = 7200;
+
+	if (*p == 'J' || *p == 'M')
+		rule -> type = *p++;
+	if (*p < '0' || *p > '9')
+		return 0;
+	while (*p >= '0' && *p <= '9')
+		value = (value * 10) + (*p++ - '0');
+
+	if (rule -> type == 'M')
+	{
+		rule -> month = value;
+		if (*p++ != '.' || *p < '1' || *p > '5')
+			return 0;
+		rule -> week = *p++ - '0';
+		if (*p++ != '.' || *p < '0' || *p > '6')
+			return 0;
+		rule -> day = *p++ - '0';
+		if (rule -> month < 1 || rule -> month > 12)
+			return 0;
+	}
+	else
+	{
+		rule -> day = value;
+		if (rule -> type == 'J' ? (value < 1 || value > 365) : value > 365)
+			return 0;
+	}
+	if (*p == '/')
+	{
+		++p;
+		if (!zoneParseTime (&p, &rule -> secs))
+			return 0;
+	}
+	*posix = p;
+	return 1;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  P A R S E  F O O T E R                                                                                   *
+ *  ===============================                                                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read the POSIX TZ string used for times after the last transition.
+ *  \param zone Zone to add the rules to.
+ *  \param posix The TZ string from the end of the file.
+ *  \result 1 if the string was understood.
+ */
+static int zoneParseFooter (ZONE_DATA *zone, char *posix)
+{
+	int offset;
+	char *rules;
+
+	if (!zoneParseName (&posix, zone -> footerNames[0], 32))
+		return 0;
+	if (!zoneParseTime (&posix, &offset))
+		return 0;
+
+	zone -> footerTypes[0].gmtOffset = -offset;
+	zone -> footerTypes[0].isDst = 0;
+	zone -> footerTypes[0].abbr = zone -> footerNames[0];
+	if (*posix == 0)
+		return 1;
+
+	/*------------------------------------------------------------------------------------------------*
+	 * DST defaults to an hour ahead of standard time and the US rules.                               *
+	 *------------------------------------------------------------------------------------------------*/
+	if (!zoneParseName (&posix, zone -> footerNames[1], 32))
+		return 0;
+	zone -> footerTypes[1].gmtOffset = zone -> footerTypes[0].gmtOffset + 3600;
+	if (*posix && *posix != ',')
+	{
+		if (!zoneParseTime (&posix, &offset))
+			return 0;
+		zone -> footerTypes[1].gmtOffset = -offset;
+	}
+	zone -> footerTypes[1].isDst = 1;
+	zone -> footerTypes[1].abbr = zone -> footerNames[1];
+
+	rules = (*posix == ',' ? posix + 1 : defaultRules);
+	if (*posix != ',' && *posix != 0)
+		return 0;
+	if (!zoneParseRule (&rules, &zone -> footerRules[0]) || *rules++ != ',')
+		return 0;
+	if (!zoneParseRule (&rules, &zone -> footerRules[1]) || *rules != 0)
+		return 0;
+
+	zone -> footerDst = 1;
+	return 1;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  P A R S E                                                                                                *
+ *  ==================                                                                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Convert the contents of a TZif file into a zone, the 64 bit block is used if there is one.
+ *  \param buffer The file contents.
+ *  \param size Size of the file.
+ *  \result The new zone or NULL if the file was not usable.
+ */
+static ZONE_DATA *zoneParse (unsigned char *buffer, int size)
+{
+	unsigned char *p = buffer, *end = buffer + size;
+	unsigned int isUtCount, isStdCount, leapCount, timeCount, typeCount, charCount;
+	long long dataSize;
+	unsigned int i;
+	int timeSize = 4;
+	ZONE_DATA *zone;
+	char *abbrs;
+
+	while (1)
+	{
+		if (end - p < 44 || memcmp (p, "TZif", 4) != 0)
+			return NULL;
+
+		isUtCount = (unsigned int)zoneGetNumber (&p[20], 4);
+		isStdCount = (unsigned int)zoneGetNumber (&p[24], 4);
+		leapCount = (unsigned int)zoneGetNumber (&p[28], 4);
+		timeCount = (unsigned int)zoneGetNumber (&p[32], 4);
+		typeCount = (unsigned int)zoneGetNumber (&p[36], 4);
+		charCount = (unsigned int)zoneGetNumber (&p[40], 4);
+		if (isUtCount > MAX_ZONE_COUNT || isStdCount > MAX_ZONE_COUNT || leapCount > MAX_ZONE_COUNT ||
+				timeCount > MAX_ZONE_COUNT || typeCount > 256 || typeCount == 0 || charCount > MAX_ZONE_COUNT)
+		{
+			return NULL;
+		}
+
+		dataSize = ((long long)timeCount * (timeSize + 1)) + (typeCount * 6) + charCount +
+				((long long)leapCount * (timeSize + 4)) + isStdCount + isUtCount;
+		if (end - (p + 44) < dataSize)
+			return NULL;
+
+		if (timeSize == 8 || p[4] < '2')
+			break;
+
+		p += 44 + dataSize;
+		timeSize = 8;
+	}
+
+	/*------------------------------------------------------------------------------------------------*
+	 * Leap second zones do not match the system clock, leave those to the C library.                 *
+	 *------------------------------------------------------------------------------------------------*/
+	if (leapCount != 0)
+		return NULL;
+
+	zone = (ZONE_DATA *)malloc (sizeof (ZONE_DATA) + (timeCount * sizeof (long long)) +
+			(typeCount * sizeof (ZONE_TYPE)) + timeCount + charCount + 1);
+	if (zone == NULL)
+		return NULL;
+
+	memset (zone, 0, sizeof (ZONE_DATA));
+	zone -> transCount = timeCount;
+	zone -> typeCount = typeCount;
+	zone -> transTimes = (long long *)&zone[1];
+	zone -> types = (ZONE_TYPE *)&zone -> transTimes[timeCount];
+	zone -> transTypes = (unsigned char *)&zone -> types[typeCount];
+	abbrs = (char *)&zone -> transTypes[timeCount];
+
+	p += 44;
+	for (i = 0; i < timeCount; ++i)
+	{
+		zone -> transTimes[i] = zoneGetNumber (p, timeSize);
+		p += timeSize;
+	}
+	for (i = 0; i < timeCount; ++i)
+	{
+		if ((zone -> transTypes[i] = *p++) >= typeCount)
+		{
+			free (zone);
+			return NULL;
+		}
+	}
+	memcpy (abbrs, p + (typeCount * 6), charCount);
+	abbrs[charCount] = 0;
+	for (i = 0; i < typeCount; ++i)
+	{
+		zone -> types[i].gmtOffset = (int)zoneGetNumber (p, 4);
+		zone -> types[i].isDst = p[4];
+		zone -> types[i].abbr = &abbrs[p[5] < charCount ? p[5] : charCount];
+		p += 6;
+	}
+	p += charCount + (leapCount * (timeSize + 4)) + isStdCount + isUtCount;
+
+	/*------------------------------------------------------------------------------------------------*
+	 * Version 2 and later files end with a POSIX TZ string between new lines.                        *
+	 *------------------------------------------------------------------------------------------------*/
+	if (timeSize == 8 && p < end && *p == '\n')
+	{
+		unsigned char *footEnd = ++p;
+		char posix[128];
+
+		while (footEnd < end && *footEnd != '\n')
+			++footEnd;
+		if (footEnd < end && footEnd - p > 0 && (size_t)(footEnd - p) < sizeof (posix))
+		{
+			memcpy (posix, p, footEnd - p);
+			posix[footEnd - p] = 0;
+			zone -> hasFooter = zoneParseFooter (zone, posix);
+		}
+	}
+	return zone;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  L O A D                                                                                                  *
+ *  ================                                                                                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Read and parse the zone file for a time zone.
+ *  \param timeZone Time zone to load.
+ *  \result The zone or NULL if it could not be loaded.
+ */
+static ZONE_DATA *zoneLoad (TZ_INFO *timeZone)
+{
+	char fileName[PATH_MAX];
+	unsigned char *buffer;
+	ZONE_DATA *zone = NULL;
+	struct stat statBuf;
+	char *zoneDir;
+	int handle, readSize = 0;
+
+	if (timeZone -> value != 0 && timeZone -> value < FIRST_CITY)
+		return &gmtZone;
+
+	if (timeZone -> value == 0)
+	{
+		strcpy (fileName, localZoneFile);
+	}
+	else
+	{
+		if ((zoneDir = getenv ("TZDIR")) == NULL || zoneDir[0] == 0)
+			zoneDir = "/usr/share/zoneinfo";
+		if (snprintf (fileName, PATH_MAX, "%s/%s", zoneDir, timeZone -> envName) >= PATH_MAX)
+			return NULL;
+	}
+
+	if ((handle = open (fileName, O_RDONLY | O_CLOEXEC)) == -1)
+		return NULL;
+
+	if (fstat (handle, &statBuf) == 0 && statBuf.st_size > 0 && statBuf.st_size <= MAX_ZONE_FILE)
+	{
+		if ((buffer = (unsigned char *)malloc (statBuf.st_size)) != NULL)
+		{
+			int bytes;
+
+			while (readSize < statBuf.st_size &&
+					(bytes = read (handle, &buffer[readSize], statBuf.st_size - readSize)) > 0)
+			{
+				readSize += bytes;
+			}
+			if (readSize == statBuf.st_size)
+				zone = zoneParse (buffer, readSize);
+			free (buffer);
+		}
+	}
+	close (handle);
+	return zone;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  R U L E  C H A N G E                                                                                     *
+ *  =============================                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Work out when a POSIX rule changes the clocks in a given year.
+ *  \param rule The rule.
+ *  \param year Full year number.
+ *  \param gmtOffset Offset in force before the change.
+ *  \result The UTC time of the change.
+ */
+static long long zoneRuleChange (ZONE_RULE *rule, long long year, int gmtOffset)
+{
+	long long days = zoneDaysFromCivil (year, 1, 1);
+	int leap = zoneIsLeap (year);
+
+	switch (rule -> type)
+	{
+	case 'J':
+		days += rule -> day - 1;
+		if (rule -> day >= 60 && leap)
+			++days;
+		break;
+
+	case 'D':
+		days += rule -> day;
+		break;
+
+	case 'M':
+		{
+			long long first = zoneDaysFromCivil (year, rule -> month, 1);
+			int dayOfWeek = (int)((first + 4) % 7), day, i;
+
+			if (dayOfWeek < 0)
+				dayOfWeek += 7;
+			day = rule -> day - dayOfWeek;
+			if (day < 0)
+				day += 7;
+			for (i = 1; i < rule -> week; ++i)
+			{
+				if (day + 7 >= monthDays[leap][rule -> month - 1])
+					break;
+				day += 7;
+			}
+			days = first + day;
+		}
+		break;
+	}
+	return (days * SECS_PER_DAY) + rule -> secs - gmtOffset;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  F I N D  T Y P E                                                                                         *
+ *  =========================                                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Find the local time type in force at a time.
+ *  \param zone Zone to look in.
+ *  \param t UTC time in secs from 1970.
+ *  \param until Return the time the type next changes, LLONG_MAX if it never does.
+ *  \result The local time type.
+ */
+static ZONE_TYPE *zoneFindType (ZONE_DATA *zone, long long t, long long *until)
+{
+	int low, high, i;
+
+	*until = LLONG_MAX;
+
+	/*------------------------------------------------------------------------------------------------*
+	 * Before the first change use the first standard time type, as the C library does.               *
+	 *------------------------------------------------------------------------------------------------*/
+	if (zone -> transCount == 0 || t < zone -> transTimes[0])
+	{
+		if (zone -> transCount != 0)
+			*until = zone -> transTimes[0];
+		for (i = 0; i < zone -> typeCount; ++i)
+		{
+			if (!zone -> types[i].isDst)
+				return &zone -> types[i];
+		}
+		return &zone -> types[0];
+	}
+
+	/*------------------------------------------------------------------------------------------------*
+	 * After the last change the footer rules, worked out for the UTC year, take over. As the rules   *
+	 * are only checked against the UTC year the result is only known to hold until the year ends.    *
+	 *------------------------------------------------------------------------------------------------*/
+	if (t >= zone -> transTimes[zone -> transCount - 1])
+	{
+		if (zone -> hasFooter)
+		{
+			long long year, start, end;
+			int month, day, isDst;
+
+			if (!zone -> footerDst)
+				return &zone -> footerTypes[0];
+
+			zoneCivilFromDays (zoneFloorDiv (t, SECS_PER_DAY), &year, &month, &day);
+			start = zoneRuleChange (&zone -> footerRules[0], year, zone -> footerTypes[0].gmtOffset);
+			end = zoneRuleChange (&zone -> footerRules[1], year, zone -> footerTypes[1].gmtOffset);
+			if (start > end)
+				isDst = (t < end || t >= start);
+			else
+				isDst = (t >= start && t < end);
+
+			*until = zoneDaysFromCivil (year + 1, 1, 1) * SECS_PER_DAY;
+			if (start > t && start < *until)
+				*until = start;
+			if (end > t && end < *until)
+				*until = end;
+			return &zone -> footerTypes[isDst];
+		}
+		return &zone -> types[zone -> transTypes[zone -> transCount - 1]];
+	}
+
+	low = 0;
+	high = zone -> transCount - 1;
+	while (high - low > 1)
+	{
+		i = (low + high) / 2;
+		if (zone -> transTimes[i] <= t)
+			low = i;
+		else
+			high = i;
+	}
+	*until = zone -> transTimes[high];
+	return &zone -> types[zone -> transTypes[low]];
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  Z O N E  L O C A L  T I M E                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**
+ *  \brief Convert a time to local time in a time zone, without setting TZ.
+ *  \param timeZone Time zone to use, the zone file is read the first time.
+ *  \param t Time in secs from 1970.
+ *  \param tm Put the local time here.
+ *  \param nextChange If not NULL return the time the offset next changes.
+ *  \result 1 if converted, 0 if the zone could not be read.
+ */
+int zoneLocalTime (TZ_INFO *timeZone, time_t t, struct tm *tm, time_t *nextChange)
+{
+	ZONE_DATA *zone;
+	ZONE_TYPE *type;
+	long long local, days, year, secs, until;
+	int month, day;
+
+	if (!timeZone -> zoneLoaded)
+	{
+		timeZone -> zoneData = zoneLoad (timeZone);
+		timeZone -> zoneLoaded = 1;
+	}
+	if ((zone = (ZONE_DATA *)timeZone -> zoneData) == NULL)
+		return 0;
+
+	type = zoneFindType (zone, t, &until);
+	if (nextChange != NULL)
+		*nextChange = (time_t)until;
+	local = (long long)t + type -> gmtOffset;
+	days = zoneFloorDiv (local, SECS_PER_DAY);
+	secs = local - (days * SECS_PER_DAY);
+	zoneCivilFromDays (days, &year, &month, &day);
+
+	memset (tm, 0, sizeof (struct tm));
+	tm -> tm_sec = (int)(secs % 60);
+	tm -> tm_min = (int)((secs / 60) % 60);
+	tm -> tm_hour = (int)(secs / 3600);
+	tm -> tm_mday = day;
+	tm -> tm_mon = month - 1;
+	tm -> tm_year = (int)(year - 1900);
+	tm -> tm_wday = (int)((days + 4) % 7);
+	if (tm -> tm_wday < 0)
+		tm -> tm_wday += 7;
+	tm -> tm_yday = (int)(days - zoneDaysFromCivil (year, 1, 1));
+	tm -> tm_isdst = type -> isDst ? 1 : 0;
+	tm -> tm_gmtoff = type -> gmtOffset;
+	tm -> tm_zone = type -> abbr;
+	return 1;
+}
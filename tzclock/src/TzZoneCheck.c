@@ -0,0 +1,255 @@
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  T Z  Z O N E  C H E C K . C                                                                                       *
+ *  ===========================                                                                                       *
+ *                                                                                                                    *
+ *  Copyright (c) 2023 Chris Knight                                                                                   *
+ *                                                                                                                    *
+ *  File TzZoneCheck.c part of TzClock is free software: you can redistribute it and/or modify it under the terms of  *
+ *  the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or  *
+ *  (at your option) any later version.                                                                               *
+ *                                                                                                                    *
+ *  TzClock is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied     *
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more     *
+ *  details.                                                                                                          *
+ *                                                                                                                    *
+ *  You should have received a copy of the GNU General Public License along with this program. If not, see:           *
+ *  <http://www.gnu.org/licenses/>                                                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+
+/**
+ *  \file
+ *  \brief Check the zone file reader gives the same local time as the C library, for every zone.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+
+#include "TzClockDisp.h"
+#include "ParseZone.h"
+
+#define CHECK_START		-2208988800LL	/* 1900 */
+#define CHECK_END		7258118400LL	/* 2200 */
+#define CHECK_STEP		86400
+
+static unsigned long checkCount = 0;
+static unsigned long checkFailed = 0;
+static int edgeOffsets[] = { -86400, -3601, -3600, -1801, -1, 0, 1, 1799, 3599, 3600, 86400 };
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  C H E C K  T I M E                                                                                                *
+ *  ==================                                                                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+
+/**
+ *  \brief Convert a time both ways and report it if they differ.
+ *  \param timeZone Zone being checked, TZ is already set to match.
+ *  \param t Time to check.
+ *  \result None.
+ */
+static void checkTime (TZ_INFO *timeZone, long long t)
+{
+	struct tm ours, libc;
+	time_t checkTime = (time_t)t;
+
+	if (localtime_r (&checkTime, &libc) == NULL)
+		return;
+
+	++checkCount;
+	if (!zoneLocalTime (timeZone, checkTime, &ours, NULL) ||
+			ours.tm_sec != libc.tm_sec || ours.tm_min != libc.tm_min || ours.tm_hour != libc.tm_hour ||
+			ours.tm_mday != libc.tm_mday || ours.tm_mon != libc.tm_mon || ours.tm_year != libc.tm_year ||
+			ours.tm_wday != libc.tm_wday || ours.tm_yday != libc.tm_yday || ours.tm_isdst != libc.tm_isdst ||
+			ours.tm_gmtoff != libc.tm_gmtoff || strcmp (ours.tm_zone, libc.tm_zone) != 0)
+	{
+		if (++checkFailed <= 20)
+		{
+			printf ("%s %lld: ours %04d-%02d-%02d %02d:%02d:%02d %s, libc %04d-%02d-%02d %02d:%02d:%02d %s\n",
+					timeZone -> envName, t,
+					ours.tm_year + 1900, ours.tm_mon + 1, ours.tm_mday, ours.tm_hour, ours.tm_min, ours.tm_sec,
+					ours.tm_zone ? ours.tm_zone : "?",
+					libc.tm_year + 1900, libc.tm_mon + 1, libc.tm_mday, libc.tm_hour, libc.tm_min, libc.tm_sec,
+					libc.tm_zone);
+		}
+	}
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  C H E C K  E D G E S                                                                                              *
+ *  ====================                                                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+
+/**
+ *  \brief Check the times either side of a change.
+ *  \param timeZone Zone being checked.
+ *  \param t Time of the change.
+ *  \result None.
+ */
+static void checkEdges (TZ_INFO *timeZone, long long t)
+{
+	unsigned int i;
+
+	for (i = 0; i < sizeof (edgeOffsets) / sizeof (edgeOffsets[0]); ++i)
+		checkTime (timeZone, t + edgeOffsets[i]);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  S A M E  T Y P E                                                                                                  *
+ *  ================                                                                                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+
+/**
+ *  \brief See if the C library gives the same offset, dst flag and name for two times.
+ *  \param first First time.
+ *  \param second Second time.
+ *  \result 1 if they are the same.
+ */
+static int sameType (time_t first, time_t second)
+{
+	struct tm firstTm, secondTm;
+
+	if (localtime_r (&first, &firstTm) == NULL || localtime_r (&second, &secondTm) == NULL)
+		return 1;
+
+	return firstTm.tm_gmtoff == secondTm.tm_gmtoff && firstTm.tm_isdst == secondTm.tm_isdst &&
+			strcmp (firstTm.tm_zone, secondTm.tm_zone) == 0;
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  C H E C K  Z O N E                                                                                                *
+ *  ==================                                                                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+
+/**
+ *  \brief Check one zone at every change either side says there is, and once a day in between.
+ *  \param timeZone Zone to check.
+ *  \result None.
+ */
+static void checkZone (TZ_INFO *timeZone)
+{
+	long long t;
+	time_t nextChange;
+	struct tm tm;
+
+	if (timeZone -> value)
+		setenv ("TZ", timeZone -> envName, 1);
+	else
+		unsetenv ("TZ");
+	tzset ();
+
+	if (!zoneLocalTime (timeZone, 0, &tm, NULL))
+	{
+		printf ("%s: could not read the zone\n", timeZone -> envName);
+		++checkFailed;
+		return;
+	}
+
+	/*------------------------------------------------------------------------------------------------*
+     * Follow the changes the zone reader says there are, it returns LLONG_MAX when there are none.   *
+     *------------------------------------------------------------------------------------------------*/
+	t = CHECK_START;
+	while (t < CHECK_END && zoneLocalTime (timeZone, (time_t)t, &tm, &nextChange) && nextChange > t &&
+			nextChange < CHECK_END)
+	{
+		checkEdges (timeZone, nextChange);
+		t = nextChange;
+	}
+
+	/*------------------------------------------------------------------------------------------------*
+     * Step through a day at a time, finding the changes the C library sees to the second             *
+     *------------------------------------------------------------------------------------------------*/
+	for (t = CHECK_START; t < CHECK_END; t += CHECK_STEP)
+	{
+		checkTime (timeZone, t);
+		if (!sameType ((time_t)t, (time_t)(t + CHECK_STEP)))
+		{
+			long long low = t, high = t + CHECK_STEP;
+
+			while (high - low > 1)
+			{
+				long long middle = low + ((high - low) / 2);
+
+				if (sameType ((time_t)low, (time_t)middle))
+					low = middle;
+				else
+					high = middle;
+			}
+			checkEdges (timeZone, high);
+		}
+	}
+	free (timeZone -> zoneData);
+}
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ *  M A I N                                                                                                           *
+ *  =======                                                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+
+/**
+ *  \brief The program starts here.
+ *  \param argc Number of arguments.
+ *  \param argv The arguments, optional zone names, otherwise all the zones in zone.tab and the local zone.
+ *  \result 0 if all the times match, 1 if any differ.
+ */
+int main (int argc, char *argv[])
+{
+	int i, zoneCount = 0;
+	TZ_INFO timeZone;
+
+	if (argc > 1)
+	{
+		for (i = 1; i < argc; ++i, ++zoneCount)
+		{
+			memset (&timeZone, 0, sizeof (timeZone));
+			timeZone.envName = argv[i];
+			timeZone.value = FIRST_CITY;
+			checkZone (&timeZone);
+		}
+	}
+	else
+	{
+		char fileName[PATH_MAX], line[512], zoneName[256], *zoneDir;
+		FILE *zoneFile;
+
+		memset (&timeZone, 0, sizeof (timeZone));
+		timeZone.envName = "Local Time";
+		checkZone (&timeZone);
+		++zoneCount;
+
+		if ((zoneDir = getenv ("TZDIR")) == NULL || zoneDir[0] == 0)
+			zoneDir = "/usr/share/zoneinfo";
+		snprintf (fileName, PATH_MAX, "%s/zone.tab", zoneDir);
+		if ((zoneFile = fopen (fileName, "r")) == NULL)
+		{
+			printf ("Cannot open %s\n", fileName);
+			return 1;
+		}
+		while (fgets (line, sizeof (line), zoneFile) != NULL)
+		{
+			if (line[0] == '#' || sscanf (line, "%*s %*s %255s", zoneName) != 1)
+				continue;
+
+			memset (&timeZone, 0, sizeof (timeZone));
+			timeZone.envName = zoneName;
+			timeZone.value = FIRST_CITY;
+			checkZone (&timeZone);
+			++zoneCount;
+		}
+		fclose (zoneFile);
+	}
+	printf ("%d zones, %lu checks, %lu mismatches\n", zoneCount, checkCount, checkFailed);
+	return checkFailed ? 1 : 0;
+}